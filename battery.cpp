@@ -0,0 +1,88 @@
+#include <Arduino.h>
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#include "battery.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  constexpr int8_t c_batteryReadEnablePin = 4;
+  constexpr int8_t c_batteryPin = A11;
+
+  // How long the divider takes to settle once enabled.
+  constexpr uint32_t c_settleMs = 50;
+
+  // Each reading is the sum of this many conversions, so is scaled up by the same.
+  constexpr uint8_t c_oversampleShift = 4;
+  constexpr uint8_t c_oversampleCount = 1 << c_oversampleShift;
+
+  // Each new reading moves the filtered level 1/(2^c_filterShift) of the way towards it.
+  constexpr uint8_t c_filterShift = 2;
+
+  // The raw ADC value for an empty battery, with each count above it a percent.
+  constexpr int16_t c_emptyRaw = 534;
+
+  uint16_t g_filtered = 0;        // Scaled by c_oversampleCount, zero until the first sample.
+  uint8_t g_percent = 0;
+
+  // Run a conversion with the CPU asleep so its noise stays out of the reading.  Any other interrupt
+  // (e.g. the millis() timer) will wake us early, so go back to sleep until it's done.
+  uint16_t quietConversion() {
+    set_sleep_mode(SLEEP_MODE_ADC);
+    ADCSRA |= bit(ADIE);
+    sleep_enable();
+    do {
+      // Entering ADC noise reduction mode starts the conversion if one isn't already running.
+      sleep_cpu();
+    } while (ADCSRA & bit(ADSC));
+    sleep_disable();
+    ADCSRA &= ~bit(ADIE);
+    return ADC;
+  }
+}
+
+// The ADC interrupt only needs to wake us.
+EMPTY_INTERRUPT(ADC_vect);
+
+// -------------------------------------------------------------------------------------------------
+
+void batteryInitialise() {
+  pinMode(c_batteryReadEnablePin, OUTPUT);
+  batterySample();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void batterySample() {
+  digitalWrite(c_batteryReadEnablePin, HIGH);
+  delay(c_settleMs);
+
+  // Let analogRead() select the pin and reference, and throw away the first conversion after the
+  // switch.
+  analogRead(c_batteryPin);
+  uint16_t sum = 0;
+  for (uint8_t count = 0; count < c_oversampleCount; count++) {
+    sum += quietConversion();
+  }
+  digitalWrite(c_batteryReadEnablePin, LOW);
+
+  if (g_filtered == 0) {
+    g_filtered = sum;
+  } else {
+    g_filtered += (static_cast<int16_t>(sum - g_filtered)) >> c_filterShift;
+  }
+
+  int16_t raw = (g_filtered + c_oversampleCount / 2) >> c_oversampleShift;
+  g_percent = max(0, min(100, raw - c_emptyRaw));
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t batteryPercent() {
+  return g_percent;
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Battery level, sampled now and then and cached so reading it costs nothing when the face is shown.
+
+void batteryInitialise();
+
+// Take a new reading, blocking for the divider to settle.  Call when there's time to spare, e.g. on
+// the hourly alarm rather than on the way to showing the face.
+void batterySample();
+
+// The filtered level as of the last sample, 0 to 100.
+uint8_t batteryPercent();
+
+// -------------------------------------------------------------------------------------------------
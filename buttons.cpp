@@ -0,0 +1,205 @@
+#include <Arduino.h>
+
+#include <util/atomic.h>
+
+#include <YetAnotherPcInt.h>
+
+#include "buttons.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  constexpr int8_t c_buttonPins[ButtonCount] = { 8, 11, 10 };
+
+  // Edges this soon after the last one on the same button are contact bounce.
+  constexpr uint16_t c_debounceMs = 20;
+
+  constexpr uint16_t c_doubleClickMs = 300;
+  constexpr uint16_t c_longPressMs = 800;
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+  // The edge queue.  The interrupts only ever write the head and the loop only ever writes the tail,
+  // each a single byte, so neither needs to lock out the other.  A full queue drops new edges.
+
+  constexpr uint8_t c_queueLen = 16;
+  static_assert((c_queueLen & (c_queueLen - 1)) == 0, "The queue length must be a power of 2.");
+
+  constexpr uint8_t c_edgePressed = 0x80;   // Or'd with the button.
+
+  volatile uint8_t g_edges[c_queueLen];
+  volatile uint16_t g_edgeMs[c_queueLen];
+  volatile uint8_t g_head = 0;
+  volatile uint8_t g_tail = 0;
+
+  // The last edge queued for each button, for debouncing, and a bit per button which has had edges
+  // dropped as bounce since.  The last of those might have been the real one, so once the bounce
+  // has settled the pin is read to catch up.
+  bool g_lastPressed[ButtonCount];
+  uint16_t g_lastEdgeMs[ButtonCount];
+  volatile uint8_t g_unsettled = 0;
+
+  void queueEdge(Button button, bool pressed) {
+    uint16_t nowMs = millis();
+    if (pressed == g_lastPressed[button]) {
+      return;
+    }
+    if (static_cast<uint16_t>(nowMs - g_lastEdgeMs[button]) < c_debounceMs) {
+      g_unsettled |= bit(button);
+      return;
+    }
+
+    uint8_t head = g_head;
+    uint8_t next = (head + 1) & (c_queueLen - 1);
+    if (next == g_tail) {
+      return;
+    }
+
+    g_lastPressed[button] = pressed;
+    g_lastEdgeMs[button] = nowMs;
+    g_edges[head] = button | (pressed ? c_edgePressed : 0);
+    g_edgeMs[head] = nowMs;
+    g_head = next;
+  }
+
+  // The pins are pulled up, so are low while pressed.
+  void upperLeftIsr(bool high) {
+    queueEdge(ButtonUpperLeft, !high);
+  }
+
+  void upperRightIsr(bool high) {
+    queueEdge(ButtonUpperRight, !high);
+  }
+
+  void lowerRightIsr(bool high) {
+    queueEdge(ButtonLowerRight, !high);
+  }
+
+  void settleBounces(uint16_t nowMs) {
+    for (uint8_t button = 0; button < ButtonCount; button++) {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if ((g_unsettled & bit(button)) != 0 &&
+            static_cast<uint16_t>(nowMs - g_lastEdgeMs[button]) >= c_debounceMs) {
+          g_unsettled &= ~bit(button);
+          queueEdge(static_cast<Button>(button), digitalRead(c_buttonPins[button]) == LOW);
+        }
+      }
+    }
+  }
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+  // The gesture decoder, one per button.
+
+  enum Phase : uint8_t {
+    PhaseIdle,
+    PhaseDown,          // Pressed, might become a click or a long press.
+    PhaseUp,            // Released after a click, might be pressed again for a double.
+    PhaseHeld,          // A long press has been reported, waiting for the release.
+  };
+
+  struct Decoder {
+    Phase phase;
+    bool clicked;       // Whether this press follows a click.
+    uint16_t sinceMs;   // When the phase started.
+  };
+
+  Decoder g_decoders[ButtonCount];
+
+  // Whether the button's gesture is decided by nowMs passing without any more edges.
+  bool timedOut(Button button, uint16_t nowMs, ButtonEvent& event) {
+    Decoder& decoder = g_decoders[button];
+    uint16_t elapsedMs = nowMs - decoder.sinceMs;
+    if (decoder.phase == PhaseDown && elapsedMs >= c_longPressMs) {
+      decoder.phase = PhaseHeld;
+      event = { button, GestureLongPress };
+      return true;
+    }
+    if (decoder.phase == PhaseUp && elapsedMs >= c_doubleClickMs) {
+      decoder.phase = PhaseIdle;
+      event = { button, GestureClick };
+      return true;
+    }
+    return false;
+  }
+
+  // Move the button's decoder on with an edge, returning whether that's a gesture.
+  bool applyEdge(Button button, bool pressed, uint16_t edgeMs, ButtonEvent& event) {
+    Decoder& decoder = g_decoders[button];
+    if (pressed) {
+      decoder.clicked = decoder.phase == PhaseUp;
+      decoder.phase = PhaseDown;
+      decoder.sinceMs = edgeMs;
+      event = { button, GesturePress };
+      return true;
+    }
+
+    if (decoder.phase == PhaseDown && decoder.clicked) {
+      decoder.phase = PhaseIdle;
+      event = { button, GestureDoubleClick };
+      return true;
+    }
+    decoder.phase = decoder.phase == PhaseDown ? PhaseUp : PhaseIdle;
+    decoder.sinceMs = edgeMs;
+    return false;
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void buttonsInitialise() {
+  // Pull the button pins high.
+  for (uint8_t button = 0; button < ButtonCount; button++) {
+    pinMode(c_buttonPins[button], INPUT_PULLUP);
+    g_lastEdgeMs[button] = millis() - c_debounceMs;
+  }
+
+  PcInt::attachInterrupt(c_buttonPins[ButtonUpperLeft], upperLeftIsr, CHANGE);
+  PcInt::attachInterrupt(c_buttonPins[ButtonUpperRight], upperRightIsr, CHANGE);
+  PcInt::attachInterrupt(c_buttonPins[ButtonLowerRight], lowerRightIsr, CHANGE);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool buttonsNextEvent(uint32_t nowMillis, ButtonEvent& event) {
+  settleBounces(nowMillis);
+
+  // Play the queued edges through the decoders in order, letting any timeouts which passed before
+  // each one go first.
+  while (g_tail != g_head) {
+    uint8_t tail = g_tail;
+    Button button = static_cast<Button>(g_edges[tail] & ~c_edgePressed);
+    bool pressed = (g_edges[tail] & c_edgePressed) != 0;
+    uint16_t edgeMs = g_edgeMs[tail];
+
+    if (timedOut(button, edgeMs, event)) {
+      return true;
+    }
+    g_tail = (tail + 1) & (c_queueLen - 1);
+    if (applyEdge(button, pressed, edgeMs, event)) {
+      return true;
+    }
+  }
+
+  for (uint8_t button = 0; button < ButtonCount; button++) {
+    if (timedOut(static_cast<Button>(button), nowMillis, event)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool buttonsBusy() {
+  if (g_tail != g_head || g_unsettled != 0) {
+    return true;
+  }
+  for (uint8_t button = 0; button < ButtonCount; button++) {
+    if (g_decoders[button].phase != PhaseIdle) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -------------------------------------------------------------------------------------------------
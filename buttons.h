@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// The three buttons.  Pin change interrupts queue each debounced press and release with when it
+// happened, and buttonsNextEvent() decodes them in the loop into presses, clicks, double clicks and
+// long presses.  The pins aren't polled, only read once after any contact bounce to be sure of where
+// they settled.
+
+enum Button : uint8_t {
+  ButtonUpperLeft,
+  ButtonUpperRight,
+  ButtonLowerRight,
+  ButtonCount,
+};
+
+enum ButtonGesture : uint8_t {
+  GesturePress,         // Every press, as soon as it happens, ahead of any of the below.
+  GestureClick,         // Pressed and released once, reported when too long has passed for a double.
+  GestureDoubleClick,
+  GestureLongPress,     // Held down, reported while it's still held.
+};
+
+struct ButtonEvent {
+  Button button;
+  ButtonGesture gesture;
+};
+
+void buttonsInitialise();
+
+// The next gesture as of nowMillis, if there is one.
+bool buttonsNextEvent(uint32_t nowMillis, ButtonEvent& event);
+
+// Whether there are presses waiting to be decoded or which can't be decoded until some time has
+// passed.  millis() stops while powered down, so don't power down while busy.
+bool buttonsBusy();
+
+// -------------------------------------------------------------------------------------------------
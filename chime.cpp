@@ -0,0 +1,159 @@
+#include <Arduino.h>
+
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+
+#include "chime.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  // OC1A, so Timer1 can drive it directly.
+  constexpr int8_t c_buzzerPin = 9;
+
+  // A note, or a rest if its frequency or volume is zero.  Each chime ends with a zero duration.
+  struct ChimeNote {
+    uint16_t hz;
+    uint16_t ms;
+    ChimeVolume volume;
+  };
+
+  constexpr ChimeNote c_hourlyNotes[] PROGMEM = {
+    { 2000, 50, VolumeLoud },
+    { 3000, 50, VolumeLoud },
+    { 2000, 50, VolumeLoud },
+    { 0, 0, VolumeOff },
+  };
+
+  // Three bursts of beeps, getting louder.
+  constexpr ChimeNote c_alarmNotes[] PROGMEM = {
+    { 4000, 100, VolumeQuiet }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeQuiet }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeQuiet }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeQuiet }, { 0, 500, VolumeOff },
+    { 4000, 100, VolumeMedium }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeMedium }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeMedium }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeMedium }, { 0, 500, VolumeOff },
+    { 4000, 100, VolumeLoud }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeLoud }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeLoud }, { 0, 100, VolumeOff },
+    { 4000, 100, VolumeLoud },
+    { 0, 0, VolumeOff },
+  };
+
+  constexpr ChimeNote c_lowBatteryNotes[] PROGMEM = {
+    { 1500, 150, VolumeMedium },
+    { 1000, 300, VolumeMedium },
+    { 0, 0, VolumeOff },
+  };
+
+  constexpr const ChimeNote* const c_chimes[ChimeCount] PROGMEM = {
+    c_hourlyNotes,
+    c_alarmNotes,
+    c_lowBatteryNotes,
+  };
+
+  // Timer3 ticks at F_CPU / 1024, so a note can last up to about 4s at 16MHz.
+  constexpr uint32_t c_durationTicksPerSec = F_CPU / 1024;
+
+  // The PWM duty cycle for each volume, as a right shift of the period.  A piezo is loudest at 50%.
+  constexpr uint8_t c_volumeDutyShifts[] = { 0, 5, 3, 1 };
+
+  const ChimeNote* volatile g_note = nullptr;
+  ChimeVolume g_volume = VolumeLoud;
+
+  void stopTimers() {
+    TIMSK3 = 0;
+    TCCR3B = 0;
+    TCCR1A = 0;
+    TCCR1B = 0;
+    digitalWrite(c_buzzerPin, LOW);
+  }
+
+  // Start playing g_note and time it, or stop if it's the end.  Called with interrupts off.
+  void startNote() {
+    uint16_t ms = pgm_read_word(&g_note->ms);
+    if (ms == 0) {
+      stopTimers();
+      g_note = nullptr;
+      return;
+    }
+
+    uint16_t hz = pgm_read_word(&g_note->hz);
+    ChimeVolume volume = static_cast<ChimeVolume>(pgm_read_byte(&g_note->volume));
+    if (volume > g_volume) {
+      volume = g_volume;
+    }
+
+    if (hz == 0 || volume == VolumeOff) {
+      TCCR1A = 0;
+      TCCR1B = 0;
+      digitalWrite(c_buzzerPin, LOW);
+    } else {
+      // Fast PWM with ICR1 as the top, clearing OC1A on a compare match, at F_CPU / 8.
+      uint16_t period = F_CPU / 8 / hz;
+      ICR1 = period - 1;
+      OCR1A = period >> c_volumeDutyShifts[volume];
+      TCNT1 = 0;
+      TCCR1A = bit(COM1A1) | bit(WGM11);
+      TCCR1B = bit(WGM13) | bit(WGM12) | bit(CS11);
+    }
+
+    // CTC with OCR3A as the top, at F_CPU / 1024.
+    TCCR3B = 0;
+    TCCR3A = 0;
+    TCNT3 = 0;
+    OCR3A = (c_durationTicksPerSec * ms) / 1000 - 1;
+    TIFR3 = bit(OCF3A);
+    TIMSK3 = bit(OCIE3A);
+    TCCR3B = bit(WGM32) | bit(CS32) | bit(CS30);
+  }
+}
+
+// The end of each note.
+ISR(TIMER3_COMPA_vect) {
+  g_note = g_note + 1;
+  startNote();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void chimeInitialise() {
+  pinMode(c_buzzerPin, OUTPUT);
+  digitalWrite(c_buzzerPin, LOW);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void chimePlay(Chime chime) {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    g_note = static_cast<const ChimeNote*>(pgm_read_ptr(&c_chimes[chime]));
+    startNote();
+  }
+}
+
+void chimeStop() {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    stopTimers();
+    g_note = nullptr;
+  }
+}
+
+bool chimePlaying() {
+  return g_note != nullptr;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void chimeSetVolume(ChimeVolume volume) {
+  g_volume = volume;
+}
+
+ChimeVolume chimeVolume() {
+  return g_volume;
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Chimes played on the buzzer by the timers, so playing one costs no foreground time.  Timer1 drives
+// the pitch on the buzzer pin as PWM, with the duty cycle setting the volume, and Timer3 interrupts
+// at the end of each note to start the next.  Both timers stop when the CPU is powered down, so
+// don't power down while chimePlaying().
+
+enum Chime : uint8_t {
+  ChimeHourly,
+  ChimeAlarm,
+  ChimeLowBattery,
+  ChimeCount,
+};
+
+enum ChimeVolume : uint8_t {
+  VolumeOff, VolumeQuiet, VolumeMedium, VolumeLoud,
+};
+
+void chimeInitialise();
+
+// Start playing a chime, cutting off anything already playing.
+void chimePlay(Chime chime);
+void chimeStop();
+bool chimePlaying();
+
+// The loudest any note is played, e.g. as set by the wearer.  Quieter notes in a chime stay quieter.
+void chimeSetVolume(ChimeVolume volume);
+ChimeVolume chimeVolume();
+
+// -------------------------------------------------------------------------------------------------
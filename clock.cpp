@@ -0,0 +1,148 @@
+#include <Arduino.h>
+
+#include <util/atomic.h>
+
+#include <uRTCLib.h>
+
+#include "clock.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  uRTCLib g_rtc(URTCLIB_ADDRESS);   // I2C address.
+
+  volatile ClockTime g_now;
+
+  // Set by each tick, so a sync can tell if one landed while the RTC was being read.
+  volatile bool g_ticked = false;
+
+  // Whether the RTC's pin is the square wave rather than the hourly alarm.
+  volatile bool g_ticking = true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void clockInitialise() {
+  g_rtc.set_model(URTCLIB_MODEL_DS3231);
+
+  // A 1Hz square wave on the INT/SQW pin rather than the hourly alarm.
+  g_rtc.alarmDisable(URTCLIB_ALARM_1);
+  g_rtc.alarmClearFlag(URTCLIB_ALARM_1);
+  g_rtc.sqwgSetMode(URTCLIB_SQWG_1H);
+
+  clockSync();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void clockSync() {
+  bool synced = false;
+  while (!synced) {
+    g_ticked = false;
+    g_rtc.refresh();
+    ClockTime time;
+    time.second = g_rtc.second();
+    time.minute = g_rtc.minute();
+    time.hour = g_rtc.hour();
+    time.dayOfWeek = g_rtc.dayOfWeek();
+    time.day = g_rtc.day();
+    time.month = g_rtc.month();
+    time.year = g_rtc.year();
+
+    // If the seconds moved on since the read began the registers may be from either side of the
+    // tick, and the tick itself would be lost under the copy, so read them again.  The check and
+    // the copy go together so a tick can't land between them.
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      if (!g_ticked) {
+        const_cast<ClockTime&>(g_now) = time;
+        synced = true;
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void clockSet(const ClockTime& time) {
+  g_rtc.set(time.second, time.minute, time.hour, time.dayOfWeek, time.day, time.month, time.year);
+  clockSync();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool clockTick() {
+  if (!g_ticking) {
+    // The hourly alarm.
+    return true;
+  }
+
+  // Only ever called with interrupts off, so the copy can be updated in place.
+  ClockTime& now = const_cast<ClockTime&>(g_now);
+  g_ticked = true;
+
+  if (++now.second < 60) {
+    return false;
+  }
+  now.second = 0;
+  if (++now.minute < 60) {
+    return false;
+  }
+  now.minute = 0;
+  if (++now.hour < 24) {
+    return true;
+  }
+  now.hour = 0;
+
+  now.dayOfWeek = (now.dayOfWeek % 7) + 1;
+  if (++now.day > daysInMonth(now.month, now.year)) {
+    now.day = 1;
+    if (++now.month > 12) {
+      now.month = 1;
+      now.year = (now.year + 1) % 100;
+    }
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void clockSleep() {
+  // Setting the alarm takes the pin from the square wave, after which nothing else comes from it
+  // until the hour.  The flag is set every hour whether the alarm is on the pin or not, so it's
+  // cleared first or the pin would go straight low.
+  g_rtc.alarmClearFlag(URTCLIB_ALARM_1);
+  g_rtc.alarmSet(URTCLIB_ALARM_TYPE_1_FIXED_MS, 0, 0, 0, 0);
+  g_ticking = false;
+}
+
+void clockWake() {
+  // Starting the square wave takes the pin back from the alarm, and the flag doesn't matter until
+  // the next sleep clears it.  It may give an edge straight away, which is taken as a tick and then
+  // overwritten by the sync.
+  g_ticking = true;
+  g_rtc.sqwgSetMode(URTCLIB_SQWG_1H);
+  clockSync();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+ClockTime clockNow() {
+  ClockTime time;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    time = const_cast<ClockTime&>(g_now);
+  }
+  return time;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t daysInMonth(uint8_t month, uint8_t year) {
+  if (month == 2) {
+    // The DS3231 only knows 2000-2099, so this is enough for leap years.
+    return (year % 4 == 0) ? 29 : 28;
+  }
+  return (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+}
+
+// -------------------------------------------------------------------------------------------------
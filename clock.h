@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// A software copy of the RTC's date and time.  It's read from the DS3231 over I2C only now and
+// then (at boot, when it's set and on waking from power down) and in between is ticked along by the
+// RTC's 1Hz square wave, so faces can read the time as often as they like without touching the bus.
+
+struct ClockTime {
+  uint8_t second, minute, hour;
+  uint8_t dayOfWeek;              // Su 1, Mo 2 ... Sa 7.
+  uint8_t day, month, year;       // 1-31, 1-12 and 00-99.
+};
+
+// Start the RTC's square wave and take a first reading.  The square wave comes out of the same pin
+// as the RTC's alarm interrupt, so only one of them can be used at a time.
+void clockInitialise();
+
+// Read the time from the RTC again, correcting any drift or missed ticks.
+void clockSync();
+
+// Set the RTC and the copy together.
+void clockSet(const ClockTime& time);
+
+// Move on a second.  Call from the square wave's falling edge interrupt, when the RTC's own seconds
+// count moves on.  Returns true if it's the start of a new hour.
+bool clockTick();
+
+// Stop the square wave for the hourly alarm instead, so powering down isn't woken every second, and
+// start it again after.  The copy doesn't tick in between, and clockTick() just returns true for
+// the alarm.  Waking reads the RTC again.
+void clockSleep();
+void clockWake();
+
+// The time as of the last tick.
+ClockTime clockNow();
+
+// The number of days in a month, 1-12, of a year, 00-99.
+uint8_t daysInMonth(uint8_t month, uint8_t year);
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,232 @@
+#include <Arduino.h>
+
+#include "battery.h"
+#include "chime.h"
+#include "clock.h"
+#include "console.h"
+#include "power.h"
+#include "ssd1306.h"
+#include "trace.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  constexpr uint8_t c_maxLineLen = 32;
+
+  char g_line[c_maxLineLen + 1];
+  uint8_t g_lineLen = 0;
+  bool g_lineOverflowed = false;
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  // Read exactly digits digits into value, moving text past them.
+  bool parseNumber(const char*& text, uint8_t digits, uint16_t& value) {
+    value = 0;
+    for (uint8_t idx = 0; idx < digits; idx++, text++) {
+      if (*text < '0' || *text > '9') {
+        return false;
+      }
+      value = value * 10 + (*text - '0');
+    }
+    return true;
+  }
+
+  bool parseChar(const char*& text, char expected) {
+    if (*text != expected) {
+      return false;
+    }
+    text++;
+    return true;
+  }
+
+  bool parseField(const char*& text, uint8_t digits, uint16_t lo, uint16_t hi, uint16_t& value) {
+    return parseNumber(text, digits, value) && value >= lo && value <= hi;
+  }
+
+  // Su 1 ... Sa 7, by Sakamoto's method.
+  uint8_t dayOfWeek(uint16_t year, uint8_t month, uint8_t day) {
+    static const uint8_t c_monthOffsets[] = { 0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4 };
+    if (month < 3) {
+      year--;
+    }
+    return (year + year / 4 - year / 100 + year / 400 + c_monthOffsets[month - 1] + day) % 7 + 1;
+  }
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  void printPadded(uint8_t value) {
+    if (value < 10) {
+      Serial.print('0');
+    }
+    Serial.print(value);
+  }
+
+  void printTime() {
+    ClockTime now = clockNow();
+    Serial.print(F("T 20"));
+    printPadded(now.year);
+    Serial.print('-');
+    printPadded(now.month);
+    Serial.print('-');
+    printPadded(now.day);
+    Serial.print(' ');
+    printPadded(now.hour);
+    Serial.print(':');
+    printPadded(now.minute);
+    Serial.print(':');
+    printPadded(now.second);
+    Serial.print(' ');
+    Serial.println(now.dayOfWeek);
+  }
+
+  // Parse 'YYYY-MM-DD HH:MM:SS [W]'.
+  bool setTime(const char* text) {
+    uint16_t year, month, day, hour, minute, second, weekday;
+    if (!(parseField(text, 4, 2000, 2099, year) && parseChar(text, '-') &&
+          parseField(text, 2, 1, 12, month) && parseChar(text, '-') &&
+          parseField(text, 2, 1, 31, day) && parseChar(text, ' ') &&
+          parseField(text, 2, 0, 23, hour) && parseChar(text, ':') &&
+          parseField(text, 2, 0, 59, minute) && parseChar(text, ':') &&
+          parseField(text, 2, 0, 59, second)) ||
+        day > daysInMonth(month, year - 2000)) {
+      return false;
+    }
+    if (*text == '\0') {
+      weekday = dayOfWeek(year, month, day);
+    } else if (!(parseChar(text, ' ') && parseField(text, 1, 1, 7, weekday) && *text == '\0')) {
+      return false;
+    }
+
+    clockSet({ static_cast<uint8_t>(second), static_cast<uint8_t>(minute),
+               static_cast<uint8_t>(hour), static_cast<uint8_t>(weekday),
+               static_cast<uint8_t>(day), static_cast<uint8_t>(month),
+               static_cast<uint8_t>(year - 2000) });
+    return true;
+  }
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  // Reply to a command which takes no arguments but was given some.
+  bool rejectArgs(char command) {
+    Serial.print(F("ERR expected "));
+    Serial.println(command);
+    return false;
+  }
+
+  // Run the command in g_line, returning true if it set the time.
+  bool runCommand(const SSD1306& display) {
+    const char* args = g_line + 1;
+    if (*args == ' ') {
+      args++;
+    }
+
+    switch (g_line[0]) {
+      case 'T':
+        if (*args == '\0') {
+          printTime();
+          return false;
+        }
+        if (setTime(args)) {
+          Serial.println(F("OK"));
+          return true;
+        }
+        Serial.println(F("ERR expected T YYYY-MM-DD HH:MM:SS [W]"));
+        return false;
+
+      case 'B':
+        if (*args != '\0') {
+          return rejectArgs('B');
+        }
+        Serial.print(F("B "));
+        Serial.println(batteryPercent());
+        return false;
+
+      case 'V':
+        if (*args >= '0' && *args <= '3' && args[1] == '\0') {
+          chimeSetVolume(static_cast<ChimeVolume>(*args - '0'));
+          chimePlay(ChimeHourly);
+        } else if (*args != '\0') {
+          Serial.println(F("ERR expected V 0-3"));
+          return false;
+        }
+        Serial.print(F("V "));
+        Serial.println(chimeVolume());
+        return false;
+
+      case 'P':
+        if (*args != '\0') {
+          return rejectArgs('P');
+        }
+        Serial.print(F("P "));
+        Serial.print(display.litPixels());
+        Serial.print(F(" lit, contrast "));
+        Serial.print(display.contrast());
+        Serial.print(F(", "));
+        Serial.print(displayCurrentUa(display.litPixels(), display.contrast()));
+        Serial.println(F("uA"));
+        return false;
+
+      case 'C':
+        if (*args != '\0') {
+          return rejectArgs('C');
+        }
+        if (SIO4_TRACE) {
+          traceDump(Serial);
+          Serial.println(F("OK"));
+        } else {
+          Serial.println(F("ERR built without SIO4_TRACE"));
+        }
+        return false;
+
+      case 'I':
+        if (*args != '\0') {
+          return rejectArgs('I');
+        }
+        Serial.print(F("I sio4 built " __DATE__ " " __TIME__ ", buffer pages "));
+        Serial.print(SSD1306_BUFFER_PAGES);
+        Serial.print(F(", trace "));
+        Serial.println(SIO4_TRACE);
+        return false;
+
+      case '?':
+        if (*args != '\0') {
+          return rejectArgs('?');
+        }
+        Serial.println(F("? T [YYYY-MM-DD HH:MM:SS [W]], B, V [0-3], P, C, I"));
+        return false;
+    }
+
+    Serial.println(F("ERR unknown command, ? for help"));
+    return false;
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool consolePoll(const SSD1306& display) {
+  bool timeSet = false;
+  while (Serial.available() > 0) {
+    char ch = Serial.read();
+    if (ch != '\r' && ch != '\n') {
+      if (g_lineLen < c_maxLineLen) {
+        g_line[g_lineLen++] = ch;
+      } else {
+        g_lineOverflowed = true;
+      }
+      continue;
+    }
+
+    if (g_lineOverflowed) {
+      Serial.println(F("ERR line too long"));
+    } else if (g_lineLen > 0) {
+      g_line[g_lineLen] = '\0';
+      timeSet |= runCommand(display);
+    }
+    g_lineLen = 0;
+    g_lineOverflowed = false;
+  }
+  return timeSet;
+}
+
+// -------------------------------------------------------------------------------------------------
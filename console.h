@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Line based commands over the USB serial port, for setting up and checking on a watch without
+// getting in the way of it running.  Each line is a command letter and its arguments, answered with
+// a line starting with the same letter, or OK or ERR:
+//
+//   T                              the current time, as below
+//   T 2026-10-17 14:05:00 [6]      set the time, with the weekday (Su 1 ... Sa 7) worked out if missing
+//   B                              the battery level, 0 to 100
+//   V [0-3]                        the chime volume, off, quiet, medium or loud, with a chime to hear it
+//   P                              the display's lit pixels, contrast and estimated current
+//   C                              the trace timings and counters, reset after printing
+//   I                              firmware information
+//   ?                              a list of commands
+
+// Handle any complete lines which have arrived, without waiting for more.  Returns true if the time
+// was set.
+bool consolePoll(const struct SSD1306& display);
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+#include <Arduino.h>
+
+#include "effects.h"
+
+#include "ssd1306.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  constexpr uint8_t c_slideRows = 12;
+  constexpr uint32_t c_slideStepMs = 15;
+
+  // The start line for each step of the wobble.  The face only moves up, so it's the blank top rows
+  // which wrap around rather than the bottom of the face.
+  constexpr uint8_t c_wobbleLines[] PROGMEM = { 0, 1, 2, 1 };
+  constexpr uint8_t c_wobbleSteps = sizeof(c_wobbleLines);
+  constexpr uint32_t c_wobbleStepMs = 200;
+
+  // Each contrast step of the blink takes 8 x (this + 1) frames, roughly 1.5s each way.
+  constexpr uint8_t c_breatheFramesPerStep8 = 1;
+}
+
+// -------------------------------------------------------------------------------------------------
+// The start line is the display RAM row shown at the top, so starting it at 64 - n puts the face n
+// rows lower, wrapping the bottom rows around to the top.
+
+void SlideTransition::start(SSD1306& display, uint32_t nowMillis) {
+  m_rowsLeft = c_slideRows;
+  m_nextStepMs = nowMillis + c_slideStepMs;
+  display.setStartLine(64 - m_rowsLeft);
+}
+
+bool SlideTransition::step(SSD1306& display, uint32_t nowMillis) {
+  if (m_rowsLeft == 0) {
+    return false;
+  }
+  if (static_cast<int32_t>(nowMillis - m_nextStepMs) < 0) {
+    return true;
+  }
+
+  m_rowsLeft--;
+  m_nextStepMs += c_slideStepMs;
+  display.setStartLine((64 - m_rowsLeft) & 63);
+  return m_rowsLeft != 0;
+}
+
+void SlideTransition::finish(SSD1306& display) {
+  if (m_rowsLeft != 0) {
+    m_rowsLeft = 0;
+    display.setStartLine(0);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// The wobble starts in place, so the first step moves it.
+
+void Wobble::start(uint32_t nowMillis) {
+  if (!m_running) {
+    m_running = true;
+    m_phase = 0;
+    m_nextStepMs = nowMillis + c_wobbleStepMs;
+  }
+}
+
+void Wobble::step(SSD1306& display, uint32_t nowMillis) {
+  if (!m_running || static_cast<int32_t>(nowMillis - m_nextStepMs) < 0) {
+    return;
+  }
+
+  m_phase = (m_phase + 1) % c_wobbleSteps;
+  m_nextStepMs += c_wobbleStepMs;
+  display.setStartLine(pgm_read_byte(&c_wobbleLines[m_phase]));
+}
+
+void Wobble::stop(SSD1306& display) {
+  if (m_running) {
+    m_running = false;
+    if (m_phase != 0) {
+      display.setStartLine(0);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void startBreathing(SSD1306& display) {
+  display.setFade(SSD1306::Blink, c_breatheFramesPerStep8);
+}
+
+void stopBreathing(SSD1306& display) {
+  display.setFade(SSD1306::FadeNone, 0);
+}
+
+// -------------------------------------------------------------------------------------------------
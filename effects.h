@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Face effects using the display's own hardware, so the face moves without being redrawn or resent.
+
+struct SlideTransition {
+
+  // Shift the display down and then slide it back up into place, one row per step.
+  void start(struct SSD1306& display, uint32_t nowMillis);
+
+  // Call from the main loop, returns whether the slide is still going.
+  bool step(struct SSD1306& display, uint32_t nowMillis);
+
+  // Jump straight to the end.
+  void finish(struct SSD1306& display);
+
+  private:
+
+  uint8_t m_rowsLeft = 0;
+  uint32_t m_nextStepMs = 0;
+};
+
+// -------------------------------------------------------------------------------------------------
+// A gentle bob up and back down by a couple of rows, looping until stopped.  Each step is a single
+// start line command from the main loop, with no redraw or flush, and the MCU idles in between.
+
+struct Wobble {
+
+  void start(uint32_t nowMillis);
+
+  // Call from the main loop, but not while a SlideTransition has the start line.
+  void step(struct SSD1306& display, uint32_t nowMillis);
+
+  // Put the face back in place.
+  void stop(struct SSD1306& display);
+
+  private:
+
+  bool m_running = false;
+  uint8_t m_phase = 0;
+  uint32_t m_nextStepMs = 0;
+};
+
+// -------------------------------------------------------------------------------------------------
+// A slow fade out and back in, looping in the display while the MCU sleeps.
+
+void startBreathing(struct SSD1306& display);
+void stopBreathing(struct SSD1306& display);
+
+// -------------------------------------------------------------------------------------------------
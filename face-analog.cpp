@@ -0,0 +1,286 @@
+#include <Arduino.h>
+
+#include "face-analog.h"
+
+#include "icons.h"
+#include "jitter.h"
+#include "ssd1306.h"
+#include "trig.h"
+
+// -------------------------------------------------------------------------------------------------
+// The dial fills the middle of the display.  The hands all cross it so any change redraws the lot,
+// but each hand's outline is only worked out when its angle changes, and jittered from there.  The
+// icons sit in the top page either side of it and are redrawn on their own.
+
+namespace {
+
+  constexpr int8_t c_centreX = 63;
+  constexpr int8_t c_centreY = 31;
+  constexpr int8_t c_radius = 31;
+
+  // Whole pages, covering the dial and anything jitter pushes past it.
+  constexpr uint8_t c_dialLeft = c_centreX - c_radius - 1;
+  constexpr uint8_t c_dialRight = c_centreX + c_radius + 1;
+  constexpr uint8_t c_dialPages = 0xff;
+
+  constexpr uint8_t c_bellLeft = 0;
+  constexpr uint8_t c_chargingLeft = 102;
+  constexpr uint8_t c_batteryLeft = 128 - c_batteryIconWidth;
+  constexpr uint8_t c_statusPages = 0x01;
+
+  // The icons' state is the battery percentage with these flags.
+  constexpr uint16_t c_chargingFlag = 1 << 8;
+  constexpr uint16_t c_chimesFlag = 1 << 9;
+
+  enum AnalogHand : uint8_t {
+    HourHand, MinuteHand, SecondHand,
+    HandCount,
+  };
+
+  // Hands are kites pointing at 12 o'clock, from a tip out at length, across at half width a quarter
+  // of the way in, to a tail behind the centre.  The seconds hand has no width so is just a line.
+  struct HandShape {
+    int8_t length, halfWidth, tail;
+  };
+
+  constexpr HandShape c_handShapes[HandCount] PROGMEM = {
+    { 17, 3, 4 },     // Hour.
+    { 27, 2, 4 },     // Minute.
+    { 29, 0, 8 },     // Second.
+  };
+
+  // The outline, tip, side, tail, side, turned to the hand's angle and placed on the dial.
+  struct HandOutline {
+    uint8_t angle;
+    TrigPoint points[4];
+  };
+
+  HandOutline g_hands[HandCount];
+  uint16_t g_status = 0;
+  bool g_shownValid = false;
+  uint8_t g_frame = 0;
+
+  // The seconds hand sweeps on from the second last drawn, as of when it was drawn.
+  int8_t g_baseSecond = 0;
+  uint32_t g_baseMs = 0;
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  uint8_t hourAngle(int8_t hour, int8_t minute) {
+    return static_cast<uint16_t>((hour % 12) * 60 + minute) * 32 / 90;
+  }
+
+  uint8_t minuteAngle(int8_t minute) {
+    return static_cast<uint16_t>(minute) * 64 / 15;
+  }
+
+  uint16_t statusValue(int16_t batteryPc, bool charging, bool chimes) {
+    return batteryPc | (charging ? c_chargingFlag : 0) | (chimes ? c_chimesFlag : 0);
+  }
+
+  uint8_t secondAngle(int8_t second, uint32_t sinceMs) {
+    uint32_t ms = (second * 1000ul + sinceMs) % 60000;
+    return ms * 16 / 3750;
+  }
+
+  void setHand(uint8_t hand, uint8_t angle) {
+    HandOutline& outline = g_hands[hand];
+    if (g_shownValid && outline.angle == angle) {
+      return;
+    }
+
+    HandShape shape;
+    memcpy_P(&shape, &(c_handShapes[hand]), sizeof(shape));
+    const int8_t offsets[4][2] = {
+      { 0, static_cast<int8_t>(-shape.length) },
+      { shape.halfWidth, static_cast<int8_t>(-shape.length / 4) },
+      { 0, shape.tail },
+      { static_cast<int8_t>(-shape.halfWidth), static_cast<int8_t>(-shape.length / 4) },
+    };
+
+    outline.angle = angle;
+    for (uint8_t point = 0; point < 4; point++) {
+      TrigPoint turned = rotatePoint(offsets[point][0], offsets[point][1], angle);
+      outline.points[point] = TrigPoint {
+        static_cast<int8_t>(c_centreX + turned.x), static_cast<int8_t>(c_centreY + turned.y)
+      };
+    }
+  }
+
+  void setHands(int8_t hour, int8_t minute, int8_t second) {
+    setHand(HourHand, hourAngle(hour, minute));
+    setHand(MinuteHand, minuteAngle(minute));
+    setHand(SecondHand, secondAngle(second, 0));
+  }
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  void drawTicks(SSD1306& display) {
+    for (uint8_t tick = 0; tick < 12; tick++) {
+      uint8_t angle = (tick * 64 + 1) / 3;
+      bool quarter = tick % 3 == 0;
+      TrigPoint inner = polarPoint(c_centreX, c_centreY, c_radius - (quarter ? 6 : 3), angle);
+      TrigPoint outer = polarPoint(c_centreX, c_centreY, c_radius, angle);
+      display.drawLine(inner.x, inner.y, outer.x, outer.y, quarter ? 2 : 1);
+    }
+  }
+
+  // Each corner of a hand is nudged once, so the sides meeting there stay joined.
+  void drawHand(SSD1306& display, uint8_t hand) {
+    const HandOutline& outline = g_hands[hand];
+    uint8_t noiseBase = jitterVertexBase(hand, outline.angle);
+    int16_t xs[4], ys[4];
+    for (uint8_t point = 0; point < 4; point++) {
+      JitterOffset offs = jitterOffset(noiseBase + point * 7);
+      xs[point] = outline.points[point].x + offs.dx;
+      ys[point] = outline.points[point].y + offs.dy;
+    }
+
+    if (hand == SecondHand) {
+      display.drawLine(xs[0], ys[0], xs[2], ys[2]);
+    } else {
+      for (uint8_t point = 0; point < 4; point++) {
+        display.drawLine(xs[point], ys[point], xs[(point + 1) % 4], ys[(point + 1) % 4]);
+      }
+    }
+  }
+
+  // The face is drawn in parts, each clearing its own box when the display is retained.  A band can
+  // only send one run of columns per page, so the parts sharing the top page get a pass each.
+  enum AnalogPart : uint8_t {
+    DialPart, BellPart, PowerPart,
+    PartCount,
+  };
+
+  void drawPart(SSD1306& display, uint8_t part, bool retain) {
+    switch (part) {
+      case DialPart:
+        if (retain) {
+          display.clearRect(c_dialLeft, 0, c_dialRight, 63);
+        }
+        jitterRewind(g_frame, 1);
+        drawTicks(display);
+        for (uint8_t hand = 0; hand < HandCount; hand++) {
+          drawHand(display, hand);
+        }
+        display.fillCircle(c_centreX, c_centreY, 2);
+        break;
+
+      case BellPart:
+        if (retain) {
+          display.clearRect(c_bellLeft, 0, c_bellLeft + c_bellIconWidth - 1, 7);
+        }
+        if (g_status & c_chimesFlag) {
+          display.drawSprite(c_bellIcon, c_bellLeft, 0, c_bellIconWidth, 1);
+        }
+        break;
+
+      case PowerPart: {
+        if (retain) {
+          display.clearRect(c_chargingLeft, 0, 127, 7);
+        }
+        if (g_status & c_chargingFlag) {
+          display.drawSprite(c_chargingIcon, c_chargingLeft, 0, c_chargingIconWidth, 1);
+        }
+        display.drawSprite(c_batteryIcon, c_batteryLeft, 0, c_batteryIconWidth, 1);
+        uint8_t fill = (g_status & 0xff) * 11 / 100;
+        if (fill > 0) {
+          display.fillRect(c_batteryLeft + 2, 3, c_batteryLeft + 1 + fill, 4);
+        }
+        break;
+      }
+    }
+  }
+
+  // Draw the parts in a picture loop each, or everything in one if the display isn't retained.
+  void drawParts(SSD1306& display, uint8_t parts, bool retain) {
+    for (uint8_t part = 0; part < PartCount; part++) {
+      if (retain && (parts & (1 << part)) == 0) {
+        continue;
+      }
+
+      display.firstPage(retain);
+      do {
+        for (uint8_t drawn = retain ? part : 0; drawn < (retain ? part + 1 : PartCount); drawn++) {
+          drawPart(display, drawn, retain);
+        }
+      } while (display.nextPage());
+
+      if (!retain) {
+        break;
+      }
+    }
+  }
+
+  bool dialChanged(int8_t hour, int8_t minute, int8_t second) {
+    return g_hands[HourHand].angle != hourAngle(hour, minute) ||
+           g_hands[MinuteHand].angle != minuteAngle(minute) ||
+           g_hands[SecondHand].angle != secondAngle(second, 0);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t analogFaceChangedPages(int8_t hour, int8_t minute, int8_t second,
+                               int16_t batteryPc, bool charging, bool chimes) {
+  if (!g_shownValid) {
+    return c_dialPages | c_statusPages;
+  }
+
+  uint8_t pages = 0;
+  if (dialChanged(hour, minute, second)) {
+    pages |= c_dialPages;
+  }
+  if (g_status != statusValue(batteryPc, charging, chimes)) {
+    pages |= c_statusPages;
+  }
+  return pages;
+}
+
+void invalidateAnalogFace() {
+  g_shownValid = false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void printAnalogFace(SSD1306& display, int8_t hour, int8_t minute, int8_t second,
+                     int16_t batteryPc, bool charging, bool chimes) {
+  g_baseSecond = second;
+  g_baseMs = millis();
+
+  uint16_t status = statusValue(batteryPc, charging, chimes);
+  bool dial = !g_shownValid || dialChanged(hour, minute, second);
+  bool statusChanged = !g_shownValid || g_status != status;
+  if (!dial && !statusChanged) {
+    return;
+  }
+
+  uint8_t parts = 0;
+  if (dial) {
+    jitterNextFrame();
+    g_frame = jitterFrame();
+    setHands(hour, minute, second);
+    parts |= 1 << DialPart;
+  }
+  if (statusChanged) {
+    parts |= (1 << BellPart) | (1 << PowerPart);
+  }
+  g_status = status;
+  drawParts(display, parts, g_shownValid);
+  g_shownValid = true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void animateAnalogFace(SSD1306& display) {
+  if (!g_shownValid) {
+    return;
+  }
+
+  jitterNextFrame();
+  g_frame = jitterFrame();
+  setHand(SecondHand, secondAngle(g_baseSecond, millis() - g_baseMs));
+  drawParts(display, 1 << DialPart, true);
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "face.h"
+
+// -------------------------------------------------------------------------------------------------
+// An analog face, a dial of ticks with jittered hands and a sweeping seconds hand, with icons for the
+// battery, charging and the chime across the top.
+
+void printAnalogFace(struct SSD1306& display, int8_t hour, int8_t minute, int8_t second,
+                     int16_t batteryPc, bool charging, bool chimes);
+
+// Which pages printAnalogFace() would redraw for these values, as a bit per page.  0 when the display
+// still shows them.
+uint8_t analogFaceChangedPages(int8_t hour, int8_t minute, int8_t second,
+                               int16_t batteryPc, bool charging, bool chimes);
+
+void invalidateAnalogFace();
+
+// Move the seconds hand on to the time now, going by millis() since the face was drawn, and jitter
+// the hands afresh.
+void animateAnalogFace(struct SSD1306& display);
+
+// The face, for the face list.
+struct AnalogFace : FaceBase {
+  static constexpr uint8_t c_framesPerSec = 4;
+
+  static void draw(struct SSD1306& display, const FaceValues& values) {
+    printAnalogFace(display, values.hour, values.minute, values.second, values.batteryPc,
+                    values.charging, values.chimes);
+  }
+
+  static uint8_t changedPages(const FaceValues& values) {
+    return analogFaceChangedPages(values.hour, values.minute, values.second, values.batteryPc,
+                                  values.charging, values.chimes);
+  }
+
+  static void animate(struct SSD1306& display, uint16_t ) {
+    animateAnalogFace(display);
+  }
+
+  static void invalidate() {
+    invalidateAnalogFace();
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
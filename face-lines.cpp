@@ -2,40 +2,51 @@
 
 #include "face-lines.h"
 
+#include "jitter.h"
 #include "ssd1306.h"
 #include "lines.h"
 #include "xorshift.h"
 
 // -------------------------------------------------------------------------------------------------
 
-void drawTime(SSD1306& display,
-              int8_t left, int8_t top, int8_t right, int8_t bottom,
-              int8_t hour, int8_t minute) {
-  // Split the space into boxes for the digits, leave a gap between each.
-  // 1A:BC - 1 - 15% / A - 25% / : - 10% / B - 25% / C - 25%
-  int16_t fullWidth = static_cast<int16_t>(right - left);
+// The time is split into boxes for the digits, leaving a gap between each.
+// 1A:BC - 1 - 15% / A - 25% / : - 10% / B - 25% / C - 25%
 
-  constexpr uint8_t gap = 2;
+constexpr uint8_t c_timeGap = 2;
+constexpr uint8_t c_timeStroke = 2;
 
+void drawHour(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t hour) {
+  int16_t fullWidth = static_cast<int16_t>(right - left);
   int16_t width15 = (fullWidth * 15) / 100;
+  int16_t width25 = fullWidth / 4;
+
   if (hour >= 10) {
     // Draw the leading 1.
-    drawNum(display, 1, left, top, left + width15 - gap, bottom, true);
+    drawNum(display, 1, left, top, left + width15 - c_timeGap, bottom, true, c_timeStroke);
   }
+  drawNum(display, hour % 10,
+          left + width15 + c_timeGap, top,
+          left + width15 + width25 - c_timeGap, bottom, true, c_timeStroke);
+}
 
+void drawTimeColon(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom) {
+  int16_t fullWidth = static_cast<int16_t>(right - left);
+  int16_t width15 = (fullWidth * 15) / 100;
   int16_t width25 = fullWidth / 4;
-  drawNum(display, hour % 10,
-          left + width15 + gap, top,
-          left + width15 + width25 - gap, bottom, true);
+  int16_t width50 = fullWidth / 2;
+
+  drawColon(display, 3, left + width15 + width25 + 1, top, left + width50 - 1, bottom, true, c_timeStroke);
+}
+
+void drawMinute(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t minute) {
+  int16_t width25 = static_cast<int16_t>(right - left) / 4;
+
   drawNum(display, minute / 10,
-          right - width25 - width25 + gap, top,
-          right - width25 - gap, bottom, true);
+          right - width25 - width25 + c_timeGap, top,
+          right - width25 - c_timeGap, bottom, true, c_timeStroke);
   drawNum(display, minute % 10,
-          right - width25 + gap, top,
-          right - gap, bottom, true);
-
-  int16_t width50 = fullWidth / 2;
-  drawColon(display, 2, left + width15 + width25 + 1, top, left + width50 - 1, bottom, true);
+          right - width25 + c_timeGap, top,
+          right - c_timeGap, bottom, true, c_timeStroke);
 }
 
 // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
@@ -46,9 +57,9 @@ void drawSeconds(SSD1306& display,
   int8_t gap = 1;
 
   uint16_t rand = xorShift();
-  int8_t vertAdjust = ((rand >> 0) % 3) - 1;
+  int8_t vertAdjust = jitterNudge(rand >> 0);
   drawNum(display, second / 10, left, top + vertAdjust, mid - gap, bottom + vertAdjust, false);
-  vertAdjust = ((rand >> 2) % 3) - 1;
+  vertAdjust = jitterNudge(rand >> 2);
   drawNum(display, second % 10, mid + gap, top + vertAdjust, right, bottom + vertAdjust, false);
 }
 
@@ -87,14 +98,14 @@ void drawPercentage(SSD1306& display, int8_t left, int8_t top, int8_t right, int
   // 100% - 1 - 10% / 0 25% / % 15%
 
   uint16_t rand = xorShift();
-  int8_t vertAdjust = ((rand >> 0) % 3) - 1;
+  int8_t vertAdjust = jitterNudge(rand >> 0);
 
   int8_t gap = 1;
   int8_t mid = getMid(left, right);
 
   int8_t width25 = (right - left) / 4;
   if (pc >= 100) {
-    int8_t horizAdjust = ((rand >> 2) % 3) - 1;
+    int8_t horizAdjust = jitterNudge(rand >> 2);
     drawNum(display, 1,
             left + gap + horizAdjust,
             top + gap + vertAdjust,
@@ -104,7 +115,7 @@ void drawPercentage(SSD1306& display, int8_t left, int8_t top, int8_t right, int
   }
 
   if (pc >= 10) {
-    int8_t horizAdjust = ((rand >> 4) % 3) - 1;
+    int8_t horizAdjust = jitterNudge(rand >> 4);
     drawNum(display, (pc / 10) % 10,
             mid - width25 + gap + horizAdjust,
             top + gap + vertAdjust,
@@ -112,7 +123,7 @@ void drawPercentage(SSD1306& display, int8_t left, int8_t top, int8_t right, int
             bottom - gap + vertAdjust,
             false);
   }
-  int8_t horizAdjust = ((rand >> 6) % 3) - 1;
+  int8_t horizAdjust = jitterNudge(rand >> 6);
   drawNum(display, pc % 10,
           mid + gap + horizAdjust,
           top + gap + vertAdjust,
@@ -120,7 +131,7 @@ void drawPercentage(SSD1306& display, int8_t left, int8_t top, int8_t right, int
           bottom - gap + vertAdjust,
           false);
 
-  horizAdjust = ((rand >> 8) % 3) - 1;
+  horizAdjust = jitterNudge(rand >> 8);
   drawPercent(display,
               right - width25 + gap + horizAdjust,
               top + gap + vertAdjust,
@@ -139,78 +150,257 @@ constexpr char thuDay[3] PROGMEM = { 't', 'h', 'u' };
 constexpr char friDay[3] PROGMEM = { 'f', 'r', 'i' };
 constexpr char satDay[3] PROGMEM = { 's', 'a', 't' };
 
-constexpr char* dayNames[7] PROGMEM = {
+constexpr const char* const dayNames[7] PROGMEM = {
   sunDay, monDay, tueDay, wedDay, thuDay, friDay, satDay,
 };
 
-void drawDate(SSD1306& display,
-              int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t month,
-              int8_t day, int8_t dayOfWeek) {
-  // Split the space into boxes for the digits, leave a gap between each.
-  // DAY DD/MM - split into 8, with 1/2 for the space and slash.
+// The date line is split into eighths, DAY DD/MM, with half an eighth for the slash.
+
+void drawWeekday(SSD1306& display,
+                 int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t dayOfWeek) {
   int8_t width8th = (right - left) / 8;
   int8_t gap = 1;
 
   uint16_t rand = xorShift();
-  int8_t vertAdjust = ((rand >> 0) % 3) - 1;
+  int8_t vertAdjust = jitterNudge(rand >> 0);
 
-  char* dayNameAddr = pgm_read_word(&(dayNames[dayOfWeek - 1]));
+  const char* dayNameAddr = static_cast<const char*>(pgm_read_ptr(&(dayNames[dayOfWeek - 1])));
 
-  // Write the day name.
-  int8_t posLeft = left + ((rand >> 12) % 3) - 1;
+  int8_t posLeft = left + jitterNudge(rand >> 12);
   for (int16_t letterIdx = 0; letterIdx < 3; letterIdx++) {
     char letter = pgm_read_byte(dayNameAddr + letterIdx);
     drawLetter(display, letter, posLeft + gap, top + vertAdjust, posLeft + width8th - gap, bottom + vertAdjust, false);
-    posLeft += width8th + ((rand >> (letterIdx * 4 + 0)) % 3) - 1;
-    vertAdjust = ((rand >> (letterIdx * 4 + 2)) % 3) - 1;
+    posLeft += width8th + jitterNudge(rand >> (letterIdx * 4 + 0));
+    vertAdjust = jitterNudge(rand >> (letterIdx * 4 + 2));
   }
+}
 
-  // Get a new random.
-  rand = xorShift();
+void drawDayMonth(SSD1306& display,
+                  int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t month, int8_t day) {
+  int8_t width8th = (right - left) / 8;
+  int8_t gap = 1;
+
+  uint16_t rand = xorShift();
+  int8_t vertAdjust = jitterNudge(rand >> 1);
 
   // Start the date aligned from the right.
-  posLeft = right - ((right - left) / 2) - (width8th / 2) + ((rand >> 0) % 3) - 1;
+  int8_t posLeft = right - ((right - left) / 2) - (width8th / 2) + jitterNudge(rand >> 0);
   if (day >= 10) {
     drawNum(display, day / 10, posLeft + gap, top + vertAdjust, posLeft + width8th - gap, bottom + vertAdjust, false);
   }
-  posLeft += width8th + ((rand >> 2) % 3) - 1;
-  vertAdjust = ((rand >> 4) % 3) - 1;
+  posLeft += width8th + jitterNudge(rand >> 2);
+  vertAdjust = jitterNudge(rand >> 4);
   drawNum(display, day % 10, posLeft + gap, top + vertAdjust, posLeft + width8th - gap, bottom + vertAdjust, false);
-  posLeft += width8th + ((rand >> 6) % 3) - 1;
+  posLeft += width8th + jitterNudge(rand >> 6);
   vertAdjust = 0;
 
   // The slash.
   drawLine(display, posLeft + (width8th / 2) - gap, top + vertAdjust, posLeft + gap, bottom + vertAdjust, false);
-  posLeft += (width8th / 2) + ((rand >> 8) % 3) - 1;
-  vertAdjust = ((rand >> 10) % 3) - 1;
+  posLeft += (width8th / 2) + jitterNudge(rand >> 8);
+  vertAdjust = jitterNudge(rand >> 10);
 
   drawNum(display, month / 10, posLeft + gap, top + vertAdjust, posLeft + width8th - gap, bottom + vertAdjust, false);
-  posLeft += width8th + ((rand >> 12) % 3) - 1;
-  vertAdjust = ((rand >> 14) % 3) - 1;
+  posLeft += width8th + jitterNudge(rand >> 12);
+  vertAdjust = jitterNudge(rand >> 14);
   drawNum(display, month % 10, posLeft + gap, top + vertAdjust, posLeft + width8th - gap, bottom + vertAdjust, false);
 }
 
 // -------------------------------------------------------------------------------------------------
-// Draw the time using lines.
+// The face is kept as a set of elements, each with the value it last drew and the frame it was
+// jittered in.  Only the elements which have changed are cleared and redrawn, leaving the rest of the
+// display RAM alone, and the first time through everything is drawn.
+
+namespace {
+
+  enum LinesElement : uint8_t {
+    HourElement, ColonElement, MinuteElement, AmPmElement,
+    WeekdayElement, DateElement, BatteryElement,
+    ElementCount,
+  };
+
+  struct ElementBox {
+    uint8_t left, top, right, bottom;
+  };
+
+  // Each box holds everything its element draws, jitter included, and covers whole pages so that no
+  // two elements share a byte of display RAM.
+  constexpr ElementBox c_elementBoxes[ElementCount] PROGMEM = {
+    {   0,  0,  39, 47 },     // Hour.
+    {  40,  0,  50, 47 },     // Colon.
+    {  51,  0,  97, 47 },     // Minute.
+    {  98,  0, 127, 47 },     // AM/PM.
+    {   0, 48,  42, 63 },     // Weekday.
+    {  43, 48,  98, 63 },     // Date.
+    {  99, 48, 127, 63 },     // Battery.
+  };
+
+  // We need to make sure there's room in our bounding boxes for the random adjustments and the bold
+  // strokes, which grow right and down, so don't go right to the edges of the display.
+  constexpr ElementBox c_timeBox = { 4, 4, 95, 45 };
+
+  struct ElementState {
+    uint16_t value;
+    uint8_t frame;
+  };
+
+  ElementState g_elements[ElementCount];
+  bool g_shownValid = false;
+  uint8_t g_nextAnimated = 0;
+
+  void faceValues(uint16_t* values,
+                  int8_t month, int8_t day, int8_t hour, int8_t minute,
+                  int8_t dayOfWeek,
+                  int16_t batteryPc) {
+    bool isAm = hour < 12;
+    if (hour == 0) { hour = 12;  }
+    if (hour > 12) { hour -= 12; }
+
+    values[HourElement] = hour;
+    values[ColonElement] = 0;
+    values[MinuteElement] = minute;
+    values[AmPmElement] = isAm;
+    values[WeekdayElement] = dayOfWeek;
+    values[DateElement] = (month << 5) | day;
+    values[BatteryElement] = batteryPc;
+  }
+
+  void drawElement(SSD1306& display, uint8_t element, uint16_t value) {
+    switch (element) {
+      case HourElement:
+        drawHour(display, c_timeBox.left, c_timeBox.top, c_timeBox.right, c_timeBox.bottom, value);
+        break;
+
+      case ColonElement:
+        drawTimeColon(display, c_timeBox.left, c_timeBox.top, c_timeBox.right, c_timeBox.bottom);
+        break;
+
+      case MinuteElement:
+        drawMinute(display, c_timeBox.left, c_timeBox.top, c_timeBox.right, c_timeBox.bottom, value);
+        break;
+
+      case AmPmElement:
+        drawAmPm(display, 100, 8, 124, 30, value != 0);
+        break;
+
+      case WeekdayElement:
+        drawWeekday(display, 4, 54, 96, 62, value);
+        break;
+
+      case DateElement:
+        drawDayMonth(display, 4, 54, 96, 62, value >> 5, value & 0x1f);
+        break;
+
+      case BatteryElement:
+        drawPercentage(display, 100, 54, 124, 62, value);
+        break;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// Draw some elements in a picture loop, clearing their boxes first if the rest of the display is
+// being retained.
+
+void drawElements(SSD1306& display, uint8_t elements, bool retain) {
+  display.firstPage(retain);
+  do {
+    for (uint8_t element = 0; element < ElementCount; element++) {
+      if (elements & (1 << element)) {
+        if (retain) {
+          ElementBox box;
+          memcpy_P(&box, &(c_elementBoxes[element]), sizeof(box));
+          display.clearRect(box.left, box.top, box.right, box.bottom);
+        }
+        jitterRewind(g_elements[element].frame, element + 1);
+        drawElement(display, element, g_elements[element].value);
+      }
+    }
+  } while (display.nextPage());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t linesFaceChangedPages(int8_t month, int8_t day, int8_t hour, int8_t minute,
+                              int8_t dayOfWeek,
+                              int16_t batteryPc) {
+  if (!g_shownValid) {
+    return 0xff;
+  }
+
+  uint16_t values[ElementCount];
+  faceValues(values, month, day, hour, minute, dayOfWeek, batteryPc);
+  uint8_t pages = 0;
+  for (uint8_t element = 0; element < ElementCount; element++) {
+    if (g_elements[element].value != values[element]) {
+      ElementBox box;
+      memcpy_P(&box, &(c_elementBoxes[element]), sizeof(box));
+      for (uint8_t page = box.top / 8; page <= box.bottom / 8; page++) {
+        pages |= 1 << page;
+      }
+    }
+  }
+  return pages;
+}
+
+void invalidateLinesFace() {
+  g_shownValid = false;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Draw the time using lines, redrawing only what has changed since the last call.
 
 void printLinesFace(SSD1306& display,
-                    int8_t month, int8_t day, int8_t hour, int8_t minute, int8_t second,
+                    int8_t month, int8_t day, int8_t hour, int8_t minute, int8_t ,
                     int8_t dayOfWeek,
                     int16_t batteryPc) {
-  bool isAm = hour < 12;
-  if (hour == 0) { hour = 12;  }
-  if (hour > 12) { hour -= 12; }
-
-  // We need to make sure there's room in our bounding boxes for the random adjustments.  Don't go
-  // right to the edges of the display
-  display.clear();
-  drawTime(display, 4, 4, 96, 46, hour, minute);
-  drawTime(display, 5, 5, 95, 45, hour, minute);
-  //drawSeconds(display, 100, 34, 124, 46, second);
-  drawAmPm(display, 100, 8, 124, 30, isAm);
-  drawDate(display, 4, 54, 96, 62, month, day, dayOfWeek);
-  drawPercentage(display, 100, 54, 124, 62, batteryPc);
-  display.flush();
+  uint16_t values[ElementCount];
+  faceValues(values, month, day, hour, minute, dayOfWeek, batteryPc);
+
+  // Changed elements get jittered afresh, the rest keep the frame they were drawn in.
+  jitterNextFrame();
+  uint8_t changed = 0;
+  for (uint8_t element = 0; element < ElementCount; element++) {
+    if (!g_shownValid || g_elements[element].value != values[element]) {
+      g_elements[element] = ElementState { values[element], jitterFrame() };
+      changed |= 1 << element;
+    }
+  }
+  if (changed == 0) {
+    return;
+  }
+
+  if (!g_shownValid) {
+    drawElements(display, changed, false);
+  } else {
+    // Each element gets its own pass, as a band can only send what's been redrawn.
+    for (uint8_t element = 0; element < ElementCount; element++) {
+      if (changed & (1 << element)) {
+        drawElements(display, 1 << element, true);
+      }
+    }
+  }
+
+  g_shownValid = true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void animateLinesFace(SSD1306& display, uint16_t budgetUs) {
+  if (!g_shownValid) {
+    return;
+  }
+
+  jitterNextFrame();
+  uint32_t startUs = micros();
+  for (uint8_t count = 0; count < ElementCount; count++) {
+    ElementState& state = g_elements[g_nextAnimated];
+    state.frame = jitterFrame();
+    drawElements(display, 1 << g_nextAnimated, true);
+    g_nextAnimated = (g_nextAnimated + 1) % ElementCount;
+    if (micros() - startUs >= budgetUs) {
+      break;
+    }
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
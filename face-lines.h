@@ -1,7 +1,46 @@
 #pragma once
 
+#include "face.h"
+
 void printLinesFace(struct SSD1306& display,
                     int8_t month, int8_t day, int8_t hour, int8_t minute, int8_t second,
                     int8_t dayOfWeek,
                     int16_t batteryPc);
 
+
+// Which pages printLinesFace() would redraw for these values, as a bit per page.  0 when the display
+// still shows the face for them.
+uint8_t linesFaceChangedPages(int8_t month, int8_t day, int8_t hour, int8_t minute,
+                              int8_t dayOfWeek,
+                              int16_t batteryPc);
+
+// Forget the last face drawn, for when something else is drawn over it.
+void invalidateLinesFace();
+
+// Jitter the face afresh for animation, redrawing as many elements as fit within the budget and
+// carrying on from there next time.  At least one element is always redrawn.
+void animateLinesFace(struct SSD1306& display, uint16_t budgetUs);
+
+// The face, for the face list.
+struct LinesFace : FaceBase {
+  static constexpr uint8_t c_framesPerSec = 8;
+  static constexpr bool c_wobbles = true;
+
+  static void draw(struct SSD1306& display, const FaceValues& values) {
+    printLinesFace(display, values.month, values.day, values.hour, values.minute, values.second,
+                   values.dayOfWeek, values.batteryPc);
+  }
+
+  static uint8_t changedPages(const FaceValues& values) {
+    return linesFaceChangedPages(values.month, values.day, values.hour, values.minute,
+                                 values.dayOfWeek, values.batteryPc);
+  }
+
+  static void animate(struct SSD1306& display, uint16_t budgetUs) {
+    animateLinesFace(display, budgetUs);
+  }
+
+  static void invalidate() {
+    invalidateLinesFace();
+  }
+};
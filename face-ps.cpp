@@ -0,0 +1,225 @@
+#include <Arduino.h>
+
+#include "face-ps.h"
+
+#include "ssd1306.h"
+#include "lines.h"
+
+// -------------------------------------------------------------------------------------------------
+// The face is a line of text per page, in 21 columns of 6 pixels:
+//
+//   $ ps -ax
+//     PID TT   TIME CMD
+//       1 ?   10:08 clock
+//       2 ?   17/10 date
+//       3 ?     sat day
+//       4 ?     57% batt
+//
+//   $ _
+//
+// Each process is an element, redrawn only when its value changes, and the cursor is another.
+
+namespace {
+
+  enum PsElement : uint8_t {
+    TimeElement, DateElement, WeekdayElement, BatteryElement, CursorElement,
+    ElementCount,
+  };
+
+  constexpr uint8_t c_charWidth = 6;
+  constexpr uint8_t c_lineChars = 21;
+
+  constexpr uint8_t c_processLine = 2;  // The line of the first process.
+  constexpr uint8_t c_promptLine = 7;
+  constexpr uint8_t c_cursorChar = 2;
+
+  constexpr char c_commandLine[] PROGMEM = "$ ps -ax";
+  constexpr char c_headerLine[]  PROGMEM = "  PID TT   TIME CMD";
+  constexpr char c_commands[]    PROGMEM = "clockdate day  batt ";  // Five characters each.
+  constexpr char c_dayNames[]    PROGMEM = "sunmontuewedthufrisat";
+
+  uint16_t g_values[ElementCount];
+  bool g_shownValid = false;
+
+  void faceValues(uint16_t* values,
+                  int8_t month, int8_t day, int8_t hour, int8_t minute,
+                  int8_t dayOfWeek,
+                  int16_t batteryPc) {
+    values[TimeElement] = hour * 60 + minute;
+    values[DateElement] = (month << 5) | day;
+    values[WeekdayElement] = dayOfWeek;
+    values[BatteryElement] = batteryPc;
+    values[CursorElement] = g_values[CursorElement];
+  }
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  void drawChar(SSD1306& display, char glyph, uint8_t line, uint8_t col) {
+    int8_t left = 1 + col * c_charWidth;
+    int8_t top = line * 8;
+    drawGlyph(display, glyph, left, top, left + c_charWidth - 2, top + 6, false);
+  }
+
+  void drawText(SSD1306& display, const char* text, uint8_t len, uint8_t line) {
+    for (uint8_t col = 0; col < len; col++) {
+      if (text[col] != ' ') {
+        drawChar(display, text[col], line, col);
+      }
+    }
+  }
+
+  void drawText_P(SSD1306& display, const char* text, uint8_t line) {
+    char buffer[c_lineChars];
+    uint8_t len = strlen_P(text);
+    memcpy_P(buffer, text, len);
+    drawText(display, buffer, len, line);
+  }
+
+  // Write a number right aligned, ending just before end, with leading zeros to at least digits.
+  void putNum(char* end, uint16_t num, uint8_t digits) {
+    do {
+      *--end = '0' + num % 10;
+      num /= 10;
+      if (digits > 0) {
+        digits--;
+      }
+    } while (digits > 0 || num > 0);
+  }
+
+  // A process line, with the value right aligned in the TIME column.
+  void drawProcess(SSD1306& display, uint8_t element, uint16_t value) {
+    char text[c_lineChars];
+    memset(text, ' ', sizeof(text));
+    putNum(text + 5, element + 1, 1);
+    text[6] = '?';
+    memcpy_P(text + 16, c_commands + element * 5, 5);
+
+    char* field = text + 15;
+    switch (element) {
+      case TimeElement:
+        putNum(field - 3, value / 60, 2);
+        field[-3] = ':';
+        putNum(field, value % 60, 2);
+        break;
+
+      case DateElement:
+        putNum(field - 3, value & 0x1f, 2);
+        field[-3] = '/';
+        putNum(field, value >> 5, 2);
+        break;
+
+      case WeekdayElement:
+        memcpy_P(field - 3, c_dayNames + (value - 1) * 3, 3);
+        break;
+
+      case BatteryElement:
+        field[-1] = '%';
+        putNum(field - 1, value, 1);
+        break;
+    }
+    drawText(display, text, sizeof(text), c_processLine + element);
+  }
+
+  void drawElement(SSD1306& display, uint8_t element, uint16_t value) {
+    if (element == CursorElement) {
+      if (value != 0) {
+        drawChar(display, '_', c_promptLine, c_cursorChar);
+      }
+    } else {
+      drawProcess(display, element, value);
+    }
+  }
+
+  void clearElement(SSD1306& display, uint8_t element) {
+    if (element == CursorElement) {
+      int16_t left = 1 + c_cursorChar * c_charWidth;
+      display.clearRect(left, c_promptLine * 8, left + c_charWidth - 1, c_promptLine * 8 + 7);
+    } else {
+      uint8_t line = c_processLine + element;
+      display.clearRect(0, line * 8, 127, line * 8 + 7);
+    }
+  }
+
+  // Draw some elements in a picture loop, clearing them first if the rest of the display is being
+  // retained.
+  void drawElements(SSD1306& display, uint8_t elements, bool retain) {
+    display.firstPage(retain);
+    do {
+      if (!retain) {
+        drawText_P(display, c_commandLine, 0);
+        drawText_P(display, c_headerLine, 1);
+        drawChar(display, '$', c_promptLine, 0);
+      }
+      for (uint8_t element = 0; element < ElementCount; element++) {
+        if (elements & (1 << element)) {
+          if (retain) {
+            clearElement(display, element);
+          }
+          drawElement(display, element, g_values[element]);
+        }
+      }
+    } while (display.nextPage());
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t psFaceChangedPages(int8_t month, int8_t day, int8_t hour, int8_t minute,
+                           int8_t dayOfWeek,
+                           int16_t batteryPc) {
+  if (!g_shownValid) {
+    return 0xff;
+  }
+
+  uint16_t values[ElementCount];
+  faceValues(values, month, day, hour, minute, dayOfWeek, batteryPc);
+  uint8_t pages = 0;
+  for (uint8_t element = 0; element < CursorElement; element++) {
+    if (g_values[element] != values[element]) {
+      pages |= 1 << (c_processLine + element);
+    }
+  }
+  return pages;
+}
+
+void invalidatePsFace() {
+  g_shownValid = false;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void printPsFace(SSD1306& display,
+                 int8_t month, int8_t day, int8_t hour, int8_t minute,
+                 int8_t dayOfWeek,
+                 int16_t batteryPc) {
+  uint16_t values[ElementCount];
+  faceValues(values, month, day, hour, minute, dayOfWeek, batteryPc);
+
+  uint8_t changed = 0;
+  for (uint8_t element = 0; element < ElementCount; element++) {
+    if (!g_shownValid || g_values[element] != values[element]) {
+      g_values[element] = values[element];
+      changed |= 1 << element;
+    }
+  }
+  if (changed == 0) {
+    return;
+  }
+
+  // The processes are a page each, so can all be redrawn in one pass even in bands.
+  drawElements(display, changed, g_shownValid);
+  g_shownValid = true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void animatePsFace(SSD1306& display) {
+  if (!g_shownValid) {
+    return;
+  }
+
+  g_values[CursorElement] = !g_values[CursorElement];
+  drawElements(display, 1 << CursorElement, true);
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "face.h"
+
+// -------------------------------------------------------------------------------------------------
+// The old `ps -ax` face, the time, date, day and battery listed as processes in plain text with a
+// blinking prompt under them.
+
+void printPsFace(struct SSD1306& display,
+                 int8_t month, int8_t day, int8_t hour, int8_t minute,
+                 int8_t dayOfWeek,
+                 int16_t batteryPc);
+
+// Which pages printPsFace() would redraw for these values, as a bit per page.  0 when the display
+// still shows the face for them.
+uint8_t psFaceChangedPages(int8_t month, int8_t day, int8_t hour, int8_t minute,
+                           int8_t dayOfWeek,
+                           int16_t batteryPc);
+
+void invalidatePsFace();
+
+// Blink the cursor.
+void animatePsFace(struct SSD1306& display);
+
+// The face, for the face list.
+struct PsFace : FaceBase {
+  static constexpr uint8_t c_framesPerSec = 2;
+
+  static void draw(struct SSD1306& display, const FaceValues& values) {
+    printPsFace(display, values.month, values.day, values.hour, values.minute, values.dayOfWeek,
+                values.batteryPc);
+  }
+
+  static uint8_t changedPages(const FaceValues& values) {
+    return psFaceChangedPages(values.month, values.day, values.hour, values.minute,
+                              values.dayOfWeek, values.batteryPc);
+  }
+
+  static void animate(struct SSD1306& display, uint16_t ) {
+    animatePsFace(display);
+  }
+
+  static void invalidate() {
+    invalidatePsFace();
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
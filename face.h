@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Watch faces.  A face is a struct of static functions rather than an object, and the faces in a
+// build are listed in a FaceList whose dispatch is resolved at compile time into a compare and a
+// direct call per face.  There are no vtables, nothing on the heap, and a face left out of the list
+// is never referenced so the linker drops all of its code and data.
+
+// What a face shows.
+struct FaceValues {
+  uint8_t month, day, hour, minute, second;
+  uint8_t dayOfWeek;              // Su 1, Mo 2 ... Sa 7.
+  uint8_t batteryPc;
+  bool charging;
+  bool chimes;                    // Whether the hourly chime is on.
+};
+
+// A face derives from FaceBase and provides:
+//
+//   static void draw(SSD1306& display, const FaceValues& values);
+//     Draw the face, redrawing only what has changed since it was last drawn, or everything after
+//     invalidate().
+//
+//   static uint8_t changedPages(const FaceValues& values);
+//     Which display pages draw() would change for these values, as a bit per page.  0 when the
+//     display still shows them.
+//
+// and may hide the rest of FaceBase to animate.
+struct FaceBase {
+
+  // Frames per second to animate at while the face is showing, or 0 for a still face.
+  static constexpr uint8_t c_framesPerSec = 0;
+
+  // Whether the face bobs gently while it's showing, see Wobble.  Its top rows must be blank, as
+  // they wrap around to the bottom.
+  static constexpr bool c_wobbles = false;
+
+  // Draw the next frame of animation, in about budgetUs.
+  static void animate(struct SSD1306& , uint16_t ) {}
+
+  // Forget what's on the display, for when something else has been drawn over it.
+  static void invalidate() {}
+};
+
+// -------------------------------------------------------------------------------------------------
+// The faces in a build, selected by their index in the list.  An index past the end does nothing.
+
+template <typename... Faces> struct FaceList;
+
+template <> struct FaceList<> {
+  static constexpr uint8_t c_count = 0;
+
+  static void draw(uint8_t , struct SSD1306& , const FaceValues& ) {}
+  static uint8_t changedPages(uint8_t , const FaceValues& ) { return 0; }
+  static uint8_t framesPerSec(uint8_t ) { return 0; }
+  static bool wobbles(uint8_t ) { return false; }
+  static void animate(uint8_t , struct SSD1306& , uint16_t ) {}
+  static void invalidate(uint8_t ) {}
+};
+
+template <typename Face, typename... Rest> struct FaceList<Face, Rest...> {
+  static constexpr uint8_t c_count = 1 + sizeof...(Rest);
+
+  static void draw(uint8_t face, struct SSD1306& display, const FaceValues& values) {
+    if (face == 0) {
+      Face::draw(display, values);
+    } else {
+      FaceList<Rest...>::draw(face - 1, display, values);
+    }
+  }
+
+  static uint8_t changedPages(uint8_t face, const FaceValues& values) {
+    return face == 0 ? Face::changedPages(values) : FaceList<Rest...>::changedPages(face - 1, values);
+  }
+
+  static uint8_t framesPerSec(uint8_t face) {
+    return face == 0 ? Face::c_framesPerSec : FaceList<Rest...>::framesPerSec(face - 1);
+  }
+
+  static bool wobbles(uint8_t face) {
+    return face == 0 ? Face::c_wobbles : FaceList<Rest...>::wobbles(face - 1);
+  }
+
+  static void animate(uint8_t face, struct SSD1306& display, uint16_t budgetUs) {
+    if (face == 0) {
+      Face::animate(display, budgetUs);
+    } else {
+      FaceList<Rest...>::animate(face - 1, display, budgetUs);
+    }
+  }
+
+  static void invalidate(uint8_t face) {
+    if (face == 0) {
+      Face::invalidate();
+    } else {
+      FaceList<Rest...>::invalidate(face - 1);
+    }
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
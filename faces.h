@@ -0,0 +1,14 @@
+#pragma once
+
+#include "face.h"
+#include "face-analog.h"
+#include "face-lines.h"
+#include "face-ps.h"
+
+// -------------------------------------------------------------------------------------------------
+// The faces built into the watch, in the order the upper right button cycles through them.  The
+// first is shown from boot.  Take a face out of the list and none of it is linked.
+
+using WatchFaces = FaceList<LinesFace, AnalogFace, PsFace>;
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,128 @@
+#pragma once
+
+// =================================================================================================
+// A host stand-in for the bits of the Arduino core the watch sources use.  Enough to build and run
+// the rendering code on Linux, not a general emulation.
+// =================================================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <type_traits>
+
+// -------------------------------------------------------------------------------------------------
+// Pins, using the Leonardo (ATmega32U4) numbering.
+
+constexpr uint8_t LOW = 0;
+constexpr uint8_t HIGH = 1;
+
+constexpr uint8_t INPUT = 0;
+constexpr uint8_t OUTPUT = 1;
+constexpr uint8_t INPUT_PULLUP = 2;
+
+constexpr uint8_t A0 = 18;
+constexpr uint8_t A1 = 19;
+constexpr uint8_t A2 = 20;
+constexpr uint8_t A3 = 21;
+constexpr uint8_t A4 = 22;
+constexpr uint8_t A5 = 23;
+constexpr uint8_t A6 = 24;
+constexpr uint8_t A7 = 25;
+constexpr uint8_t A8 = 26;
+constexpr uint8_t A9 = 27;
+constexpr uint8_t A10 = 28;
+constexpr uint8_t A11 = 29;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// -------------------------------------------------------------------------------------------------
+// External interrupts, numbered the same as their pins.  They're run when a simulated device drives
+// the pin, see hal.h.
+
+constexpr int CHANGE = 1;
+constexpr int FALLING = 2;
+constexpr int RISING = 3;
+
+inline uint8_t digitalPinToInterrupt(uint8_t pin) {
+  return pin;
+}
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+
+// -------------------------------------------------------------------------------------------------
+// Time.  Delays don't sleep, they just move the clock on.
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint16_t us);
+
+// -------------------------------------------------------------------------------------------------
+// Program memory is just memory.
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(void* const*)(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+// -------------------------------------------------------------------------------------------------
+// The core defines these as macros, which would trample the standard library on the host.
+
+template <typename A, typename B> auto min(A a, B b) -> typename std::common_type<A, B>::type {
+  return a < b ? a : b;
+}
+
+template <typename A, typename B> auto max(A a, B b) -> typename std::common_type<A, B>::type {
+  return a > b ? a : b;
+}
+
+template <typename T, typename L, typename H> T constrain(T v, L lo, H hi) {
+  return v < lo ? lo : (v > hi ? hi : v);
+}
+
+#define bit(b) (1UL << (b))
+
+typedef uint8_t byte;
+
+// -------------------------------------------------------------------------------------------------
+// Printing, with Serial going to stdout.
+
+class Print {
+  public:
+
+  virtual ~Print() {}
+  virtual size_t write(uint8_t ch) = 0;
+
+  size_t print(const char* str);
+  size_t print(char ch);
+  size_t print(long val);
+  size_t print(unsigned long val);
+  size_t print(int val) { return print(static_cast<long>(val)); }
+  size_t print(unsigned val) { return print(static_cast<unsigned long>(val)); }
+
+  size_t println() { return print("\r\n"); }
+  template <typename T> size_t println(T val) { return print(val) + println(); }
+};
+
+class HostSerial : public Print {
+  public:
+
+  size_t write(uint8_t ch) override;
+};
+
+extern HostSerial Serial;
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Arduino.h"
+
+// -------------------------------------------------------------------------------------------------
+// A host stand-in for the Arduino SPI library.  Transfers are handed to whichever HostSpiDevice is
+// attached, see hal.h.
+
+constexpr uint8_t MSBFIRST = 1;
+constexpr uint8_t SPI_MODE0 = 0;
+
+struct SPISettings {
+  SPISettings(uint32_t , uint8_t , uint8_t ) {}
+};
+
+struct SPIClass {
+  void begin() {}
+  void end() {}
+
+  void beginTransaction(SPISettings ) {}
+  void endTransaction() {}
+
+  uint8_t transfer(uint8_t data);
+  void transfer(void* buf, size_t count);
+};
+
+extern SPIClass SPI;
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Arduino.h"
+
+// -------------------------------------------------------------------------------------------------
+// A host stand-in for the Arduino Wire (I2C) library.  Transactions go to whichever HostI2cDevice
+// is attached at the address, see hal.h.
+
+struct TwoWire {
+  void begin() {}
+  void setClock(uint32_t ) {}
+
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+  uint8_t endTransmission(bool stop = true);
+
+  uint8_t requestFrom(uint8_t address, uint8_t quantity);
+  int available();
+  int read();
+
+  private:
+
+  // Like the real library, at most 32 bytes each way.
+  static constexpr uint8_t c_bufferLen = 32;
+
+  uint8_t m_address = 0;
+  uint8_t m_txBuffer[c_bufferLen];
+  uint8_t m_txLen = 0;
+  uint8_t m_rxBuffer[c_bufferLen];
+  uint8_t m_rxLen = 0;
+  uint8_t m_rxIdx = 0;
+};
+
+extern TwoWire Wire;
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+#include "../face-lines.h"
+#include "../jitter.h"
+#include "../lines.h"
+#include "../ssd1306.h"
+#include "../trace.h"
+
+// =================================================================================================
+// Rendering benchmarks.  Each one draws a fixed set of inputs, reporting the time, pixels, lines and
+// SPI bytes per operation, and can be checked against a baseline to catch regressions.  The counts
+// are exact so get a tight threshold.  The time depends on the machine and whatever else it is doing,
+// so its threshold only catches something going badly wrong.
+// =================================================================================================
+
+namespace {
+
+  struct Benchmark {
+    const char* name;
+    uint32_t ops;
+    void (*run)(SSD1306& display);
+  };
+
+  struct Result {
+    double usPerOp, pixelsPerOp, linesPerOp, spiPerOp;
+  };
+
+  // A small LCG so the inputs are the same everywhere.
+  uint32_t g_lcg = 1;
+
+  int16_t lcgRange(int16_t lo, int16_t hi) {
+    g_lcg = g_lcg * 1103515245u + 12345u;
+    return lo + static_cast<int16_t>((g_lcg >> 16) % (hi - lo + 1));
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Primitives, drawn into the buffer without flushing.
+
+  void benchLines(SSD1306& display, uint8_t minWidth, uint8_t maxWidth) {
+    g_lcg = 1;
+    display.clear();
+    for (int count = 0; count < 1000; count++) {
+      int16_t ax = lcgRange(-16, 143), ay = lcgRange(-8, 71);
+      int16_t bx = lcgRange(-16, 143), by = lcgRange(-8, 71);
+      display.drawLine(ax, ay, bx, by, lcgRange(minWidth, maxWidth));
+    }
+  }
+
+  void benchThinLines(SSD1306& display) {
+    benchLines(display, 1, 1);
+  }
+
+  void benchThickLines(SSD1306& display) {
+    benchLines(display, 2, 3);
+  }
+
+  void benchGlyphs(SSD1306& display, char first, char last, uint8_t width) {
+    jitterSeed(1);
+    display.clear();
+    for (char glyph = first; glyph <= last; glyph++) {
+      for (bool jitter: { false, true }) {
+        drawLetter(display, glyph, 10, 10, 18, 20, jitter, width);
+        drawLetter(display, glyph, 40, 4, 62, 46, jitter, width);
+      }
+    }
+  }
+
+  void benchDigits(SSD1306& display) {
+    benchGlyphs(display, '0', '9', 1);
+  }
+
+  void benchBoldDigits(SSD1306& display) {
+    benchGlyphs(display, '0', '9', 2);
+  }
+
+  void benchLetters(SSD1306& display) {
+    benchGlyphs(display, 'a', 'z', 1);
+  }
+
+  void benchCircles(SSD1306& display) {
+    g_lcg = 1;
+    display.clear();
+    for (int count = 0; count < 200; count++) {
+      int16_t cx = lcgRange(0, 127), cy = lcgRange(0, 63), radius = lcgRange(1, 30);
+      if (count % 2 == 0) {
+        display.drawCircle(cx, cy, radius);
+      } else {
+        display.fillCircle(cx, cy, radius);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Whole faces, flushed to the display.
+
+  void printFace(SSD1306& display, int8_t month, int8_t day, int16_t minutes, int16_t batteryPc) {
+    printLinesFace(display, month, day, minutes / 60, minutes % 60, 0, 1 + (day % 7), batteryPc);
+  }
+
+  void benchFaceAllTimes(SSD1306& display) {
+    jitterSeed(1);
+    for (int16_t minutes = 0; minutes < 24 * 60; minutes++) {
+      invalidateLinesFace();
+      printFace(display, 10, 17, minutes, 57);
+    }
+  }
+
+  void benchFaceMinuteTicks(SSD1306& display) {
+    jitterSeed(1);
+    invalidateLinesFace();
+    for (int16_t minutes = 0; minutes <= 24 * 60; minutes++) {
+      printFace(display, 10, 17, minutes % (24 * 60), 57);
+    }
+  }
+
+  void benchFaceDates(SSD1306& display, int8_t firstDay, int8_t lastDay) {
+    jitterSeed(1);
+    for (int8_t month = 1; month <= 12; month++) {
+      for (int8_t day = firstDay; day <= lastDay; day++) {
+        invalidateLinesFace();
+        printFace(display, month, day, 10 * 60 + 8, 57);
+      }
+    }
+  }
+
+  void benchFaceOneDigitDates(SSD1306& display) {
+    benchFaceDates(display, 1, 9);
+  }
+
+  void benchFaceTwoDigitDates(SSD1306& display) {
+    benchFaceDates(display, 10, 28);
+  }
+
+  void benchFaceFullBattery(SSD1306& display) {
+    jitterSeed(1);
+    for (int count = 0; count < 100; count++) {
+      invalidateLinesFace();
+      printFace(display, 10, 17, 12 * 60 + 59, 100);
+    }
+  }
+
+  void benchFaceDateTicks(SSD1306& display) {
+    jitterSeed(1);
+    invalidateLinesFace();
+    for (int8_t day = 1; day <= 28; day++) {
+      printFace(display, 2, day, 10 * 60 + 8, 57);
+    }
+  }
+
+  void benchFaceAnimation(SSD1306& display) {
+    jitterSeed(1);
+    invalidateLinesFace();
+    printFace(display, 10, 17, 10 * 60 + 8, 57);
+    traceReset();
+    for (int count = 0; count < 700; count++) {
+      animateLinesFace(display, 0);
+    }
+  }
+
+  const Benchmark c_benchmarks[] = {
+    { "line-thin",          1000,            benchThinLines },
+    { "line-thick",         1000,            benchThickLines },
+    { "glyph-digit",        40,              benchDigits },
+    { "glyph-digit-bold",   40,              benchBoldDigits },
+    { "glyph-letter",       104,             benchLetters },
+    { "circle",             200,             benchCircles },
+    { "face-all-times",     24 * 60,         benchFaceAllTimes },
+    { "face-minute-ticks",  24 * 60 + 1,     benchFaceMinuteTicks },
+    { "face-date-1-digit",  12 * 9,          benchFaceOneDigitDates },
+    { "face-date-2-digit",  12 * 19,         benchFaceTwoDigitDates },
+    { "face-date-ticks",    28,              benchFaceDateTicks },
+    { "face-battery-100",   100,             benchFaceFullBattery },
+    { "face-animation",     700,             benchFaceAnimation },
+  };
+
+  // -----------------------------------------------------------------------------------------------
+
+  Result runBenchmark(SSD1306& display, const Benchmark& bench, int reps) {
+    // The counts are the same every time, so come from a single run.
+    traceReset();
+    bench.run(display);
+    Result result;
+    result.pixelsPerOp = static_cast<double>(traceCounter(TracePixels)) / bench.ops;
+    result.linesPerOp = static_cast<double>(traceCounter(TraceLines)) / bench.ops;
+    result.spiPerOp = static_cast<double>(traceCounter(TraceSpiBytes)) / bench.ops;
+
+    // The time is the quickest of a few runs, which is the one least disturbed by anything else.
+    using namespace std::chrono;
+    double bestUs = 0;
+    for (int rep = 0; rep < reps; rep++) {
+      steady_clock::time_point start = steady_clock::now();
+      bench.run(display);
+      double us = duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1000.0;
+      if (rep == 0 || us < bestUs) {
+        bestUs = us;
+      }
+    }
+    result.usPerOp = bestUs / bench.ops;
+    return result;
+  }
+
+  bool readBaseline(const char* path, std::map<std::string, Result>& baseline) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+      return false;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      char name[64];
+      Result result;
+      if (line[0] != '#' &&
+          sscanf(line, "%63s %lf %lf %lf %lf", name,
+                 &result.usPerOp, &result.pixelsPerOp, &result.linesPerOp, &result.spiPerOp) == 5) {
+        baseline[name] = result;
+      }
+    }
+    fclose(file);
+    return true;
+  }
+
+  // Whether value has grown more than pct percent over base, with a little slack for rounding.
+  bool regressed(double value, double base, double pct) {
+    return value > base * (1 + pct / 100) + 0.005;
+  }
+
+  void usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -c FILE     check against a baseline, failing on any regression\n"
+            "  -p PCT      threshold for pixels, lines and SPI bytes (default 2)\n"
+            "  -t PCT      threshold for time (default 200)\n"
+            "  -r N        timed runs per benchmark, the fastest counts (default 20)\n"
+            "  -b NAME     only run benchmarks starting with NAME\n"
+            "\n"
+            "Results are printed in the baseline format.\n",
+            prog);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+  const char* baselinePath = nullptr;
+  const char* filter = "";
+  double countPct = 2, timePct = 200;
+  int reps = 20;
+
+  for (int argIdx = 1; argIdx < argc; argIdx++) {
+    const char* opt = argv[argIdx];
+    const char* val = argIdx + 1 < argc ? argv[argIdx + 1] : nullptr;
+    if (opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0' || val == nullptr) {
+      usage(argv[0]);
+      return 1;
+    }
+    argIdx++;
+
+    switch (opt[1]) {
+      case 'c': baselinePath = val; break;
+      case 'p': countPct = atof(val); break;
+      case 't': timePct = atof(val); break;
+      case 'r': reps = atoi(val); break;
+      case 'b': filter = val; break;
+      default: usage(argv[0]); return 1;
+    }
+  }
+
+  std::map<std::string, Result> baseline;
+  if (baselinePath != nullptr && !readBaseline(baselinePath, baseline)) {
+    fprintf(stderr, "Failed to read baseline %s.\n", baselinePath);
+    return 1;
+  }
+
+  SSD1306 display;
+  display.initialise();
+
+  printf("# %-20s  %10s  %10s  %10s  %10s\n", "benchmark", "us/op", "pixels/op", "lines/op", "spi/op");
+  std::vector<std::string> failures;
+  for (const Benchmark& bench: c_benchmarks) {
+    if (strncmp(bench.name, filter, strlen(filter)) != 0) {
+      continue;
+    }
+
+    Result result = runBenchmark(display, bench, reps);
+    printf("  %-20s  %10.3f  %10.2f  %10.2f  %10.2f\n",
+           bench.name, result.usPerOp, result.pixelsPerOp, result.linesPerOp, result.spiPerOp);
+
+    if (baselinePath == nullptr) {
+      continue;
+    }
+    auto found = baseline.find(bench.name);
+    if (found == baseline.end()) {
+      fprintf(stderr, "%s: not in the baseline\n", bench.name);
+      continue;
+    }
+
+    const Result& base = found->second;
+    struct { const char* metric; double value, base, pct; } checks[] = {
+      { "us/op",     result.usPerOp,     base.usPerOp,     timePct },
+      { "pixels/op", result.pixelsPerOp, base.pixelsPerOp, countPct },
+      { "lines/op",  result.linesPerOp,  base.linesPerOp,  countPct },
+      { "spi/op",    result.spiPerOp,    base.spiPerOp,    countPct },
+    };
+    for (const auto& check: checks) {
+      if (regressed(check.value, check.base, check.pct)) {
+        char failure[128];
+        snprintf(failure, sizeof(failure), "%s %s: %.3f, baseline %.3f (+%.0f%%)", bench.name,
+                 check.metric, check.value, check.base, (check.value / check.base - 1) * 100);
+        failures.push_back(failure);
+      }
+    }
+  }
+
+  for (const std::string& failure: failures) {
+    fprintf(stderr, "REGRESSION %s\n", failure.c_str());
+  }
+  return failures.empty() ? 0 : 1;
+}
+
+// =================================================================================================
@@ -0,0 +1,284 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+#include "sim-ssd1306.h"
+
+#include "../ssd1306.h"
+#include "../trace.h"
+
+// =================================================================================================
+// Encode images as PROGMEM bitmaps for SSD1306::streamBitmap() and drawSprite(), or check that each
+// codec streams a set of frames back exactly.
+//
+// Images are PBMs as the simulator writes them, looking like the screen, so a white (0) pixel is lit.
+// =================================================================================================
+
+namespace {
+
+  // An image in the display's layout, a byte per column of each page.
+  struct Bitmap {
+    uint8_t width = 0, pages = 0;
+    std::vector<uint8_t> bytes;
+
+    uint8_t at(uint8_t page, uint8_t col) const { return bytes[page * width + col]; }
+  };
+
+  bool readPbm(const char* path, Bitmap& bitmap) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+      return false;
+    }
+
+    char magic[3] = {};
+    int width = 0, height = 0;
+    bool ok = fscanf(file, "%2s %d %d", magic, &width, &height) == 3 &&
+              (strcmp(magic, "P1") == 0 || strcmp(magic, "P4") == 0) &&
+              width > 0 && width <= 128 && height > 0 && height <= 64;
+    if (ok) {
+      bitmap.width = width;
+      bitmap.pages = (height + 7) / 8;
+      bitmap.bytes.assign(bitmap.width * bitmap.pages, 0);
+      fgetc(file);
+
+      bool plain = magic[1] == '1';
+      std::vector<uint8_t> row((width + 7) / 8);
+      for (int y = 0; ok && y < height; y++) {
+        if (!plain) {
+          ok = fread(row.data(), 1, row.size(), file) == row.size();
+        }
+        for (int x = 0; ok && x < width; x++) {
+          int val = 0;
+          if (plain) {
+            ok = fscanf(file, " %1d", &val) == 1;
+          } else {
+            val = (row[x / 8] >> (7 - x % 8)) & 1;
+          }
+          if (val == 0) {
+            bitmap.bytes[(y / 8) * width + x] |= 1 << (y % 8);
+          }
+        }
+      }
+    }
+    fclose(file);
+    return ok;
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // The codecs, as described in ssd1306.h.
+
+  std::vector<uint8_t> encodeRle(const Bitmap& bitmap) {
+    const std::vector<uint8_t>& bytes = bitmap.bytes;
+    std::vector<uint8_t> out;
+    size_t idx = 0;
+    while (idx < bytes.size()) {
+      size_t run = 1;
+      while (idx + run < bytes.size() && run < 128 && bytes[idx + run] == bytes[idx]) {
+        run++;
+      }
+      if (run >= 3) {
+        out.push_back(0x7f + run);
+        out.push_back(bytes[idx]);
+        idx += run;
+        continue;
+      }
+
+      // Literals, up to the next run worth repeating.
+      size_t end = idx;
+      while (end < bytes.size() && end - idx < 128 &&
+             !(end + 2 < bytes.size() && bytes[end] == bytes[end + 1] && bytes[end] == bytes[end + 2])) {
+        end++;
+      }
+      out.push_back(end - idx - 1);
+      out.insert(out.end(), bytes.begin() + idx, bytes.begin() + end);
+      idx = end;
+    }
+    return out;
+  }
+
+  // Runs of changed columns a few bytes apart are sent as one, as a window costs more than that.
+  constexpr int c_deltaMergeGap = 8;
+
+  std::vector<uint8_t> encodeDelta(const Bitmap& prev, const Bitmap& bitmap) {
+    std::vector<uint8_t> out;
+    for (uint8_t page = 0; page < bitmap.pages; page++) {
+      int col = 0;
+      while (col < bitmap.width) {
+        if (bitmap.at(page, col) == prev.at(page, col)) {
+          col++;
+          continue;
+        }
+
+        int left = col, right = col;
+        for (int next = col + 1; next < bitmap.width && next - right <= c_deltaMergeGap && next - left < 128;
+             next++) {
+          if (bitmap.at(page, next) != prev.at(page, next)) {
+            right = next;
+          }
+        }
+        out.push_back(page);
+        out.push_back(left);
+        out.push_back(right - left);
+        for (int idx = left; idx <= right; idx++) {
+          out.push_back(bitmap.at(page, idx));
+        }
+        col = right + 1;
+      }
+    }
+    out.push_back(0xff);
+    return out;
+  }
+
+  void printArray(const char* name, const Bitmap& bitmap, const char* codec,
+                  const std::vector<uint8_t>& bytes) {
+    printf("// %u x %u pages, %s.\n", bitmap.width, bitmap.pages, codec);
+    printf("constexpr uint8_t %s[%zu] PROGMEM = {", name, bytes.size());
+    for (size_t idx = 0; idx < bytes.size(); idx++) {
+      printf("%s0x%02x,", idx % 16 == 0 ? "\n  " : " ", bytes[idx]);
+    }
+    printf("\n};\n");
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Stream each frame with each codec into a simulated display and check it comes out the same.
+
+  bool matches(const SimSSD1306& sim, const Bitmap& bitmap) {
+    for (uint8_t page = 0; page < bitmap.pages; page++) {
+      for (uint8_t col = 0; col < bitmap.width; col++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+          if (sim.pixel(col, page * 8 + bit) != ((bitmap.at(page, col) >> bit) & 1)) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  bool check(const std::vector<Bitmap>& frames, const std::vector<std::string>& paths) {
+    SimSSD1306 sim(A3, A5);
+    hostAttachSpiDevice(&sim);
+    SSD1306 display;
+    display.initialise();
+    display.clear();
+    display.flush();
+
+    printf("%-24s  %-6s  %10s  %10s  %12s  %7s\n",
+           "frame", "codec", "flash", "spi-bytes", "transactions", "counted");
+    bool ok = true;
+    for (size_t idx = 0; idx < frames.size(); idx++) {
+      const Bitmap& frame = frames[idx];
+      const Bitmap& prev = frames[idx == 0 ? 0 : idx - 1];
+      std::vector<uint8_t> encodings[3] = { frame.bytes, encodeRle(frame), encodeDelta(prev, frame) };
+      const char* names[3] = { "raw", "rle", "delta" };
+
+      for (int codec = SSD1306::BitmapRaw; codec <= SSD1306::BitmapDelta; codec++) {
+        // Deltas go on top of the previous frame, the rest on a blank display.
+        if (codec == SSD1306::BitmapDelta) {
+          display.streamBitmap(prev.bytes.data(), 0, 0, prev.width, prev.pages);
+        } else {
+          display.clear();
+          display.flush();
+        }
+
+        sim.resetStats();
+        display.streamBitmap(encodings[codec].data(), 0, 0, frame.width, frame.pages,
+                             static_cast<SSD1306::BitmapCodec>(codec));
+        bool same = matches(sim, frame);
+        printf("%-24s  %-6s  %10zu  %10u  %12u  %7u%s\n",
+               paths[idx].substr(paths[idx].find_last_of('/') + 1).c_str(), names[codec],
+               encodings[codec].size(), sim.stats().spiBytes(), sim.stats().transactions,
+               display.litPixels(), same ? "" : "  MISMATCH");
+        ok = ok && same;
+      }
+    }
+    return ok;
+  }
+
+  void usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s [options] IMAGE.pbm\n"
+            "       %s -t FRAME.pbm...\n"
+            "  -n NAME     array name (default c_bitmap)\n"
+            "  -c CODEC    raw, rle or delta (default raw)\n"
+            "  -p PREV     the previous frame, for delta\n"
+            "  -t          check each codec streams the frames back exactly\n"
+            "\n"
+            "Prints the bitmap as a PROGMEM array.\n",
+            prog, prog);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+  const char* name = "c_bitmap";
+  std::string codec = "raw";
+  const char* prevPath = nullptr;
+  bool checking = false;
+  std::vector<std::string> paths;
+
+  for (int argIdx = 1; argIdx < argc; argIdx++) {
+    const char* opt = argv[argIdx];
+    if (opt[0] != '-') {
+      paths.push_back(opt);
+      continue;
+    }
+    if (strcmp(opt, "-t") == 0) {
+      checking = true;
+      continue;
+    }
+
+    const char* val = argIdx + 1 < argc ? argv[argIdx + 1] : nullptr;
+    if (opt[1] == '\0' || opt[2] != '\0' || val == nullptr) {
+      usage(argv[0]);
+      return 1;
+    }
+    argIdx++;
+
+    switch (opt[1]) {
+      case 'n': name = val; break;
+      case 'c': codec = val; break;
+      case 'p': prevPath = val; break;
+      default: usage(argv[0]); return 1;
+    }
+  }
+
+  if (paths.empty() || (!checking && paths.size() != 1) ||
+      (codec != "raw" && codec != "rle" && codec != "delta") || (codec == "delta") != (prevPath != nullptr)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<Bitmap> frames(paths.size());
+  for (size_t idx = 0; idx < paths.size(); idx++) {
+    if (!readPbm(paths[idx].c_str(), frames[idx]) ||
+        (idx > 0 && (frames[idx].width != frames[0].width || frames[idx].pages != frames[0].pages))) {
+      fprintf(stderr, "Failed to read %s, or it's not the size of the first.\n", paths[idx].c_str());
+      return 1;
+    }
+  }
+
+  if (checking) {
+    return check(frames, paths) ? 0 : 1;
+  }
+
+  if (codec == "delta") {
+    Bitmap prev;
+    if (!readPbm(prevPath, prev) || prev.width != frames[0].width || prev.pages != frames[0].pages) {
+      fprintf(stderr, "Failed to read %s, or it's not the same size.\n", prevPath);
+      return 1;
+    }
+    printArray(name, frames[0], "delta", encodeDelta(prev, frames[0]));
+  } else {
+    printArray(name, frames[0], codec.c_str(), codec == "rle" ? encodeRle(frames[0]) : frames[0].bytes);
+  }
+  return 0;
+}
+
+// =================================================================================================
@@ -0,0 +1,173 @@
+#include <math.h>
+
+#include "Arduino.h"
+
+#include "fake-mpu6050.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  constexpr uint8_t c_regSampleRateDiv = 0x19;
+  constexpr uint8_t c_regAccelConfig = 0x1c;
+  constexpr uint8_t c_regMotionThreshold = 0x1f;
+  constexpr uint8_t c_regMotionDuration = 0x20;
+  constexpr uint8_t c_regFifoEnable = 0x23;
+  constexpr uint8_t c_regIntPinConfig = 0x37;
+  constexpr uint8_t c_regIntEnable = 0x38;
+  constexpr uint8_t c_regIntStatus = 0x3a;
+  constexpr uint8_t c_regAccelOut = 0x3b;
+  constexpr uint8_t c_regUserControl = 0x6a;
+  constexpr uint8_t c_regPowerManagement1 = 0x6b;
+  constexpr uint8_t c_regPowerManagement2 = 0x6c;
+  constexpr uint8_t c_regFifoCountHigh = 0x72;
+  constexpr uint8_t c_regFifoCountLow = 0x73;
+  constexpr uint8_t c_regFifoData = 0x74;
+  constexpr uint8_t c_regWhoAmI = 0x75;
+
+  constexpr size_t c_fifoLen = 1024;
+
+  // At +/-2g.
+  constexpr int32_t c_lsbPerG = 16384;
+
+  // The high pass filter's cutoff for each ACCEL_HPF mode, in Hz.  0 is Reset, which holds the
+  // filter's output at zero, and Hold isn't modelled.
+  const float c_hpfCutoffHz[8] = { 0, 5, 2.5, 1.25, 0.63, 0, 0, 0 };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+FakeMpu6050::FakeMpu6050(uint8_t intPin)
+  : m_intPin(intPin) {
+  reset();
+}
+
+void FakeMpu6050::reset() {
+  memset(m_regs, 0, sizeof(m_regs));
+  m_regs[c_regPowerManagement1] = 0x40;   // Asleep.
+  m_regs[c_regWhoAmI] = 0x68;
+  m_fifo.clear();
+  m_haveLast = false;
+  m_motionCount = 0;
+  hostDrivePin(m_intPin, HIGH);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void FakeMpu6050::i2cWritten(const uint8_t* bytes, uint8_t len) {
+  if (len == 0) {
+    return;
+  }
+  m_regPtr = bytes[0] & 0x7f;
+  for (uint8_t idx = 1; idx < len; idx++) {
+    writeRegister(m_regPtr, bytes[idx]);
+    m_regPtr = (m_regPtr + 1) & 0x7f;
+  }
+}
+
+void FakeMpu6050::writeRegister(uint8_t reg, uint8_t value) {
+  if (reg == c_regPowerManagement1 && (value & 0x80) != 0) {
+    reset();
+    return;
+  }
+  if (reg == c_regUserControl && (value & 0x04) != 0) {
+    m_fifo.clear();
+    value &= ~0x04;
+  }
+  m_regs[reg] = value;
+}
+
+uint8_t FakeMpu6050::i2cRead() {
+  uint8_t reg = m_regPtr;
+  if (reg == c_regFifoData) {
+    // Reads keep coming from the FIFO rather than moving on.
+    if (m_fifo.empty()) {
+      return 0;
+    }
+    uint8_t value = m_fifo.front();
+    m_fifo.pop_front();
+    return value;
+  }
+
+  m_regPtr = (m_regPtr + 1) & 0x7f;
+  switch (reg) {
+    case c_regFifoCountHigh: return m_fifo.size() >> 8;
+    case c_regFifoCountLow: return m_fifo.size() & 0xff;
+    case c_regIntStatus: {
+      uint8_t status = m_regs[reg];
+      if ((m_regs[c_regIntPinConfig] & 0x10) != 0) {
+        m_regs[reg] = 0;
+        hostDrivePin(m_intPin, (m_regs[c_regIntPinConfig] & 0x80) != 0 ? HIGH : LOW);
+      }
+      return status;
+    }
+    default: return m_regs[reg];
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint16_t FakeMpu6050::sampleIntervalMs() const {
+  if ((m_regs[c_regPowerManagement1] & 0x20) != 0) {
+    // Cycling at the low power wake rate: 1.25, 5, 20 or 40Hz.
+    static const uint16_t c_cycleMs[] = { 800, 200, 50, 25 };
+    return c_cycleMs[m_regs[c_regPowerManagement2] >> 6];
+  }
+  // The accelerometer runs at 1kHz, divided down.
+  return 1 + m_regs[c_regSampleRateDiv];
+}
+
+void FakeMpu6050::sample(int16_t xMg, int16_t yMg, int16_t zMg) {
+  if ((m_regs[c_regPowerManagement1] & 0x40) != 0) {
+    return;
+  }
+
+  int16_t raw[3];
+  int16_t mg[3] = { xMg, yMg, zMg };
+  for (int axis = 0; axis < 3; axis++) {
+    int32_t value = static_cast<int32_t>(mg[axis]) * c_lsbPerG / 1000;
+    raw[axis] = static_cast<int16_t>(constrain(value, -32768, 32767));
+    m_regs[c_regAccelOut + axis * 2] = raw[axis] >> 8;
+    m_regs[c_regAccelOut + axis * 2 + 1] = raw[axis] & 0xff;
+  }
+
+  // Motion is the high pass filtered value of any axis being past the threshold, which is in 2mg
+  // steps, for more than the duration.  The duration is documented in 1ms ticks at 1kHz, and here
+  // counts samples, whatever the rate.
+  float cutoffHz = c_hpfCutoffHz[m_regs[c_regAccelConfig] & 0x07];
+  float rc = cutoffHz > 0 ? 1 / (2 * M_PI * cutoffHz) : 0;
+  float decay = rc / (rc + sampleIntervalMs() / 1000.0f);
+  int32_t threshold = m_regs[c_regMotionThreshold] * 2 * c_lsbPerG / 1000;
+  bool moved = false;
+  for (int axis = 0; axis < 3; axis++) {
+    m_filtered[axis] = m_haveLast ? decay * (m_filtered[axis] + raw[axis] - m_last[axis]) : 0;
+    moved |= fabsf(m_filtered[axis]) > threshold;
+    m_last[axis] = raw[axis];
+  }
+  m_haveLast = true;
+  m_motionCount = moved ? min(m_motionCount + 1, 0xff) : 0;
+  if (m_motionCount > m_regs[c_regMotionDuration]) {
+    setInterrupt(0x40);
+  }
+
+  if ((m_regs[c_regUserControl] & 0x40) != 0 && (m_regs[c_regFifoEnable] & 0x08) != 0) {
+    for (int axis = 0; axis < 3; axis++) {
+      m_fifo.push_back(raw[axis] >> 8);
+      m_fifo.push_back(raw[axis] & 0xff);
+    }
+    if (m_fifo.size() > c_fifoLen) {
+      m_fifo.erase(m_fifo.begin(), m_fifo.begin() + (m_fifo.size() - c_fifoLen));
+      setInterrupt(0x10);
+    }
+  }
+}
+
+void FakeMpu6050::setInterrupt(uint8_t bits) {
+  // Every status bit is set, but only the enabled ones drive the pin.
+  m_regs[c_regIntStatus] |= bits;
+  if ((m_regs[c_regIntEnable] & bits) != 0) {
+    hostDrivePin(m_intPin, (m_regs[c_regIntPinConfig] & 0x80) != 0 ? LOW : HIGH);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
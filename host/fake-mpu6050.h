@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <deque>
+
+#include "hal.h"
+
+// -------------------------------------------------------------------------------------------------
+// A stand-in for the MPU6050's accelerometer, its FIFO and its motion interrupt, fed samples by
+// whoever is driving the simulation.  Only what motion.cpp uses is modelled: no gyros, no low pass
+// filter, and the high pass filter the motion test is made on is a first order one at the sample
+// rate, as the datasheet doesn't say what it is.
+
+struct FakeMpu6050 : HostI2cDevice {
+
+  explicit FakeMpu6050(uint8_t intPin);
+
+  uint8_t i2cAddress() const override { return 0x68; }
+  void i2cWritten(const uint8_t* bytes, uint8_t len) override;
+  uint8_t i2cRead() override;
+
+  // How often the IMU takes a sample, as configured.
+  uint16_t sampleIntervalMs() const;
+
+  // Take a sample, in mg.  Ignored while the IMU is asleep.
+  void sample(int16_t xMg, int16_t yMg, int16_t zMg);
+
+  private:
+
+  void reset();
+  void writeRegister(uint8_t reg, uint8_t value);
+  void setInterrupt(uint8_t bits);
+
+  uint8_t m_intPin;
+
+  uint8_t m_regs[128];
+  uint8_t m_regPtr = 0;
+
+  int16_t m_last[3] = {};
+  float m_filtered[3] = {};
+  bool m_haveLast = false;
+  uint8_t m_motionCount = 0;
+
+  std::deque<uint8_t> m_fifo;
+};
+
+// -------------------------------------------------------------------------------------------------
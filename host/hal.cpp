@@ -0,0 +1,236 @@
+#include <stdio.h>
+
+#include <chrono>
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+
+#include "hal.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  HostSpiDevice* g_spiDevice = nullptr;
+
+  constexpr uint8_t c_maxI2cDevices = 4;
+  HostI2cDevice* g_i2cDevices[c_maxI2cDevices];
+  uint32_t g_i2cBytes = 0;
+
+  HostI2cDevice* findI2cDevice(uint8_t address) {
+    for (HostI2cDevice* device: g_i2cDevices) {
+      if (device != nullptr && device->i2cAddress() == address) {
+        return device;
+      }
+    }
+    return nullptr;
+  }
+
+  struct Interrupt {
+    void (*isr)();
+    int mode;
+  };
+
+  Interrupt g_interrupts[32];
+
+  uint8_t g_pinState[32];
+
+  uint32_t g_delayedUs = 0;
+
+  uint64_t hostMicros() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration_cast<microseconds>(steady_clock::now() - start).count();
+  }
+}
+
+SPIClass SPI;
+TwoWire Wire;
+HostSerial Serial;
+
+void hostAttachSpiDevice(HostSpiDevice* device) {
+  g_spiDevice = device;
+}
+
+void hostAttachI2cDevice(HostI2cDevice* device) {
+  for (HostI2cDevice*& slot: g_i2cDevices) {
+    if (slot == nullptr) {
+      slot = device;
+      return;
+    }
+  }
+}
+
+uint32_t hostI2cBytes() {
+  return g_i2cBytes;
+}
+
+void hostDrivePin(uint8_t pin, uint8_t val) {
+  uint8_t wasVal = g_pinState[pin % 32];
+  g_pinState[pin % 32] = val;
+
+  const Interrupt& interrupt = g_interrupts[pin % 32];
+  if (interrupt.isr != nullptr &&
+      ((interrupt.mode == LOW && val == LOW) ||
+       (interrupt.mode == CHANGE && val != wasVal) ||
+       (interrupt.mode == FALLING && val == LOW && wasVal != LOW) ||
+       (interrupt.mode == RISING && val != LOW && wasVal == LOW))) {
+    interrupt.isr();
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void pinMode(uint8_t , uint8_t ) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  g_pinState[pin % 32] = val;
+  if (g_spiDevice != nullptr) {
+    g_spiDevice->pinWritten(pin, val);
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  return g_pinState[pin % 32];
+}
+
+int analogRead(uint8_t ) {
+  return 0;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(), int mode) {
+  g_interrupts[interrupt % 32] = { isr, mode };
+
+  // A low level interrupt keeps firing for as long as the pin is low.
+  if (mode == LOW && g_pinState[interrupt % 32] == LOW) {
+    isr();
+  }
+}
+
+void detachInterrupt(uint8_t interrupt) {
+  g_interrupts[interrupt % 32] = { nullptr, 0 };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint32_t millis() {
+  return micros() / 1000;
+}
+
+uint32_t micros() {
+  return static_cast<uint32_t>(hostMicros()) + g_delayedUs;
+}
+
+void delay(uint32_t ms) {
+  g_delayedUs += ms * 1000;
+}
+
+void delayMicroseconds(uint16_t us) {
+  g_delayedUs += us;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  if (g_spiDevice != nullptr) {
+    g_spiDevice->byteTransferred(data);
+  }
+  return 0;
+}
+
+void SPIClass::transfer(void* buf, size_t count) {
+  // Like the real thing, overwrite the buffer with what was read back.
+  uint8_t* bytes = static_cast<uint8_t*>(buf);
+  for (size_t idx = 0; idx < count; idx++) {
+    bytes[idx] = transfer(bytes[idx]);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void TwoWire::beginTransmission(uint8_t address) {
+  m_address = address;
+  m_txLen = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (m_txLen == c_bufferLen) {
+    return 0;
+  }
+  m_txBuffer[m_txLen++] = data;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool ) {
+  HostI2cDevice* device = findI2cDevice(m_address);
+  g_i2cBytes += 1 + m_txLen;
+  if (device == nullptr) {
+    // NACK on the address.
+    return 2;
+  }
+  device->i2cWritten(m_txBuffer, m_txLen);
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  HostI2cDevice* device = findI2cDevice(address);
+  g_i2cBytes += 1;
+  m_rxLen = 0;
+  m_rxIdx = 0;
+  if (device == nullptr) {
+    return 0;
+  }
+  while (m_rxLen < quantity && m_rxLen < c_bufferLen) {
+    m_rxBuffer[m_rxLen++] = device->i2cRead();
+  }
+  g_i2cBytes += m_rxLen;
+  return m_rxLen;
+}
+
+int TwoWire::available() {
+  return m_rxLen - m_rxIdx;
+}
+
+int TwoWire::read() {
+  return m_rxIdx < m_rxLen ? m_rxBuffer[m_rxIdx++] : -1;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+size_t Print::print(const char* str) {
+  size_t len = 0;
+  while (*str != '\0') {
+    len += write(*str++);
+  }
+  return len;
+}
+
+size_t Print::print(char ch) {
+  return write(ch);
+}
+
+size_t Print::print(long val) {
+  char str[24];
+  snprintf(str, sizeof(str), "%ld", val);
+  return print(str);
+}
+
+size_t Print::print(unsigned long val) {
+  char str[24];
+  snprintf(str, sizeof(str), "%lu", val);
+  return print(str);
+}
+
+size_t HostSerial::write(uint8_t ch) {
+  // Drop the carriage returns from println().
+  if (ch != '\r') {
+    putchar(ch);
+  }
+  return 1;
+}
+
+// -------------------------------------------------------------------------------------------------
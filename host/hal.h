@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Hooks from the host Arduino stand-in to simulated peripherals.
+
+struct HostSpiDevice {
+  virtual ~HostSpiDevice() {}
+
+  virtual void pinWritten(uint8_t pin, uint8_t val) = 0;
+  virtual void byteTransferred(uint8_t byte) = 0;
+};
+
+void hostAttachSpiDevice(HostSpiDevice* device);
+
+struct HostI2cDevice {
+  virtual ~HostI2cDevice() {}
+
+  virtual uint8_t i2cAddress() const = 0;
+
+  // The bytes of a write, then the bytes of any read which follows, one at a time.
+  virtual void i2cWritten(const uint8_t* bytes, uint8_t len) = 0;
+  virtual uint8_t i2cRead() = 0;
+};
+
+void hostAttachI2cDevice(HostI2cDevice* device);
+
+// All the bytes sent and received over I2C, including addresses.
+uint32_t hostI2cBytes();
+
+// Set a pin from outside, running its interrupt if one's attached and the level or edge matches.
+void hostDrivePin(uint8_t pin, uint8_t val);
+
+// -------------------------------------------------------------------------------------------------
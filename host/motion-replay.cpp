@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "Arduino.h"
+
+#include "fake-mpu6050.h"
+
+#include "../motion.h"
+
+// =================================================================================================
+// Replay a recorded motion trace through a fake IMU and the watch's raise detection, reporting each
+// raise seen and what the wakes cost.
+//
+// A trace is lines of 'ms x y z', the time and the acceleration on each axis in mg, with Z out of the
+// face.  Lines starting with # are comments, except '# expect N' which is the number of raises the
+// trace should give and '# max wakes N' which is the most times it may wake the watch.
+// =================================================================================================
+
+namespace {
+
+  // The IMU's interrupt pin, as in motion.cpp.
+  constexpr uint8_t c_imuIntPin = 7;
+
+  struct TraceRow {
+    uint32_t ms;
+    int16_t x, y, z;
+  };
+
+  bool readTrace(const char* path, std::vector<TraceRow>& rows, int& expected, int& maxWakes) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+      return false;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      TraceRow row;
+      int x, y, z;
+      if (line[0] == '#') {
+        sscanf(line, "# expect %d", &expected);
+        sscanf(line, "# max wakes %d", &maxWakes);
+      } else if (sscanf(line, "%u %d %d %d", &row.ms, &x, &y, &z) == 4) {
+        row.x = x;
+        row.y = y;
+        row.z = z;
+        rows.push_back(row);
+      }
+    }
+    fclose(file);
+    return !rows.empty();
+  }
+
+  // The trace at ms, interpolated between rows.
+  void traceAt(const std::vector<TraceRow>& rows, uint32_t ms, int16_t& x, int16_t& y, int16_t& z) {
+    size_t idx = 0;
+    while (idx + 1 < rows.size() && rows[idx + 1].ms <= ms) {
+      idx++;
+    }
+
+    const TraceRow& a = rows[idx];
+    const TraceRow& b = rows[min(idx + 1, rows.size() - 1)];
+    int32_t span = b.ms - a.ms;
+    int32_t into = span > 0 ? min<int32_t, int32_t>(ms - a.ms, span) : 0;
+    auto lerp = [&](int16_t from, int16_t to) -> int16_t {
+      return span > 0 ? from + (to - from) * into / span : from;
+    };
+    x = lerp(a.x, b.x);
+    y = lerp(a.y, b.y);
+    z = lerp(a.z, b.z);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv) {
+  bool verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+  if (argc != (verbose ? 3 : 2)) {
+    fprintf(stderr, "Usage: %s [-v] TRACE\n", argv[0]);
+    return 1;
+  }
+
+  const char* path = argv[argc - 1];
+  std::vector<TraceRow> rows;
+  int expected = -1, maxWakes = -1;
+  if (!readTrace(path, rows, expected, maxWakes)) {
+    fprintf(stderr, "Failed to read a trace from %s.\n", path);
+    return 1;
+  }
+
+  FakeMpu6050 imu(c_imuIntPin);
+  hostAttachI2cDevice(&imu);
+  motionInitialise();
+  uint32_t setupBytes = hostI2cBytes();
+
+  uint32_t samples = 0, wakes = 0, raises = 0;
+  uint16_t intervalMs = imu.sampleIntervalMs();
+  for (uint32_t ms = 0; ms <= rows.back().ms; ms += intervalMs) {
+    int16_t x, y, z;
+    traceAt(rows, ms, x, y, z);
+    imu.sample(x, y, z);
+    samples++;
+
+    if (motionPending()) {
+      wakes++;
+      bool raised = motionCheckRaise();
+      raises += raised;
+      if (verbose || raised) {
+        printf("%7.2fs  %s  (%d, %d, %d)mg\n", ms / 1000.0, raised ? "raise" : "wake ", x, y, z);
+      }
+    }
+  }
+
+  uint32_t wakeBytes = hostI2cBytes() - setupBytes;
+  printf("%s: %u samples at %ums, %u wakes, %u raises, %u I2C bytes (%.1f per wake)\n", path,
+         samples, intervalMs, wakes, raises, wakeBytes, wakes > 0 ? double(wakeBytes) / wakes : 0.0);
+
+  if (expected >= 0 && raises != static_cast<uint32_t>(expected)) {
+    fprintf(stderr, "%s: expected %d raises\n", path, expected);
+    return 1;
+  }
+  if (maxWakes >= 0 && wakes > static_cast<uint32_t>(maxWakes)) {
+    fprintf(stderr, "%s: expected at most %d wakes\n", path, maxWakes);
+    return 1;
+  }
+  return 0;
+}
+
+// =================================================================================================
@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "sim-ssd1306.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  // How many argument bytes follow each multi-byte command.
+  uint8_t argCount(uint8_t opcode) {
+    switch (opcode) {
+      case 0x20: case 0x23: case 0x81: case 0x8d: case 0xa8: case 0xd3:
+      case 0xd5: case 0xd6: case 0xd9: case 0xda: case 0xdb:
+        return 1;
+      case 0x21: case 0x22: case 0xa3:
+        return 2;
+      case 0x29: case 0x2a:
+        return 5;
+      case 0x26: case 0x27: case 0x2c: case 0x2d:
+        return 6;
+      default:
+        return 0;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+SimSSD1306::SimSSD1306(uint8_t dataCommandPin, uint8_t chipSelectPin)
+  : m_dataCommandPin(dataCommandPin)
+  , m_chipSelectPin(chipSelectPin) {
+}
+
+void SimSSD1306::pinWritten(uint8_t pin, uint8_t val) {
+  if (pin == m_dataCommandPin) {
+    m_isData = val != 0;
+  } else if (pin == m_chipSelectPin) {
+    bool selected = val == 0;
+    if (selected && !m_selected) {
+      m_stats.transactions++;
+    }
+    m_selected = selected;
+  }
+}
+
+void SimSSD1306::byteTransferred(uint8_t byte) {
+  if (!m_selected) {
+    return;
+  }
+  if (m_isData) {
+    m_stats.dataBytes++;
+    data(byte);
+  } else {
+    m_stats.commandBytes++;
+    command(byte);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void SimSSD1306::command(uint8_t byte) {
+  if (m_cmdLen == 0) {
+    m_cmdArgs = argCount(byte);
+  }
+  m_cmd[m_cmdLen++] = byte;
+  if (m_cmdLen <= m_cmdArgs) {
+    return;
+  }
+  m_cmdLen = 0;
+
+  uint8_t op = m_cmd[0];
+  if (op <= 0x0f) {
+    m_col = (m_col & 0xf0) | op;
+  } else if (op <= 0x1f) {
+    m_col = ((op & 0x07) << 4) | (m_col & 0x0f);
+  } else if (op >= 0x40 && op <= 0x7f) {
+    m_startLine = op & 0x3f;
+  } else if (op >= 0xb0 && op <= 0xb7) {
+    m_page = op & 0x07;
+  } else {
+    switch (op) {
+      case 0x20: m_addrMode = m_cmd[1] & 0x03; break;
+      case 0x21: m_colStart = m_col = m_cmd[1] & 0x7f; m_colEnd = m_cmd[2] & 0x7f; break;
+      case 0x22: m_pageStart = m_page = m_cmd[1] & 0x07; m_pageEnd = m_cmd[2] & 0x07; break;
+      case 0x23: m_fadeMode = m_cmd[1] & 0x30; break;
+      case 0x26: case 0x27: case 0x29: case 0x2a: m_scrollSetUp = true; break;
+      case 0x2c: case 0x2d: scrollOneColumn(op == 0x2d); break;
+      case 0x2e: m_scrolling = false; break;
+      case 0x2f: m_scrolling = m_scrollSetUp; break;
+      case 0x81: m_contrast = m_cmd[1]; break;
+      case 0xa0: case 0xa1: m_segRemap = op & 1; break;
+      case 0xa4: case 0xa5: m_entireOn = op & 1; break;
+      case 0xa6: case 0xa7: m_inverted = op & 1; break;
+      case 0xae: case 0xaf: m_displayOn = op & 1; break;
+      case 0xc0: case 0xc8: m_comScanDec = (op & 0x08) != 0; break;
+      default: break;
+    }
+  }
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// One step of content scroll over the pages and columns in the current command.  Columns scroll out
+// of one end and blank columns come in at the other.
+
+void SimSSD1306::scrollOneColumn(bool left) {
+  uint8_t startCol = m_cmd[5] & 0x7f;
+  uint8_t endCol = m_cmd[6] & 0x7f;
+  for (uint8_t page = m_cmd[2] & 7; page <= (m_cmd[4] & 7); page++) {
+    uint8_t* row = m_ram[page];
+    if (left) {
+      memmove(row + startCol, row + startCol + 1, endCol - startCol);
+      row[endCol] = 0;
+    } else {
+      memmove(row + startCol + 1, row + startCol, endCol - startCol);
+      row[startCol] = 0;
+    }
+  }
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+void SimSSD1306::data(uint8_t byte) {
+  if (m_scrolling) {
+    m_stats.writesWhileScrolling++;
+  }
+  m_ram[m_page & 7][m_col & 127] = byte;
+
+  switch (m_addrMode) {
+    case 0:
+      // Horizontal: across the window then down a page, wrapping to the top.
+      if (m_col >= m_colEnd) {
+        m_col = m_colStart;
+        m_page = m_page >= m_pageEnd ? m_pageStart : m_page + 1;
+      } else {
+        m_col++;
+      }
+      break;
+
+    case 1:
+      // Vertical: down the window then across a column, wrapping to the left.
+      if (m_page >= m_pageEnd) {
+        m_page = m_pageStart;
+        m_col = m_col >= m_colEnd ? m_colStart : m_col + 1;
+      } else {
+        m_page++;
+      }
+      break;
+
+    default:
+      // Page: across the whole page, wrapping back to its start.
+      m_col = (m_col + 1) & 127;
+      break;
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool SimSSD1306::pixel(uint8_t x, uint8_t y) const {
+  if (!m_displayOn) {
+    return false;
+  }
+
+  uint8_t col = m_segRemap ? x : 127 - x;
+  uint8_t row = m_comScanDec ? y : 63 - y;
+  row = (row + m_startLine) & 63;
+
+  bool lit = m_entireOn || (m_ram[row / 8][col] & (1 << (row % 8))) != 0;
+  return lit != m_inverted;
+}
+
+uint16_t SimSSD1306::litPixels() const {
+  uint16_t count = 0;
+  for (uint8_t y = 0; y < 64; y++) {
+    for (uint8_t x = 0; x < 128; x++) {
+      count += pixel(x, y) ? 1 : 0;
+    }
+  }
+  return count;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool SimSSD1306::writePbm(const std::string& path) const {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  // Plain PBM, 1 is black, so lit pixels are written as 0 to look like the screen.
+  fprintf(file, "P1\n128 64\n");
+  for (uint8_t y = 0; y < 64; y++) {
+    for (uint8_t x = 0; x < 128; x++) {
+      fputc(pixel(x, y) ? '0' : '1', file);
+      fputc(x == 127 ? '\n' : ' ', file);
+    }
+  }
+  return fclose(file) == 0;
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// An 8-bit greyscale PNG, scaled up and stored uncompressed so we don't need zlib.
+
+namespace {
+
+  uint32_t crc32(const uint8_t* bytes, size_t len, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t idx = 0; idx < len; idx++) {
+      crc ^= bytes[idx];
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+      }
+    }
+    return ~crc;
+  }
+
+  void putBe32(std::vector<uint8_t>& out, uint32_t val) {
+    out.push_back(val >> 24);
+    out.push_back(val >> 16);
+    out.push_back(val >> 8);
+    out.push_back(val);
+  }
+
+  void putChunk(FILE* file, const char* type, const std::vector<uint8_t>& body) {
+    std::vector<uint8_t> chunk;
+    putBe32(chunk, body.size());
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), body.begin(), body.end());
+    putBe32(chunk, crc32(chunk.data() + 4, chunk.size() - 4));
+    fwrite(chunk.data(), 1, chunk.size(), file);
+  }
+}
+
+bool SimSSD1306::writePng(const std::string& path, uint8_t scale) const {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  scale = scale == 0 ? 1 : scale;
+
+  const uint32_t width = 128 * scale;
+  const uint32_t height = 64 * scale;
+
+  static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+  fwrite(signature, 1, 8, file);
+
+  std::vector<uint8_t> header;
+  putBe32(header, width);
+  putBe32(header, height);
+  header.push_back(8);    // Bit depth.
+  header.push_back(0);    // Greyscale.
+  header.push_back(0);    // Deflate.
+  header.push_back(0);    // Adaptive filtering.
+  header.push_back(0);    // No interlace.
+  putChunk(file, "IHDR", header);
+
+  // The raw scanlines, each with a 'none' filter byte.  Lit pixels are brighter with contrast.
+  const uint8_t lit = 0x60 + (m_contrast * 0x9f) / 0xff;
+  std::vector<uint8_t> raw;
+  for (uint32_t y = 0; y < height; y++) {
+    raw.push_back(0);
+    for (uint32_t x = 0; x < width; x++) {
+      raw.push_back(pixel(x / scale, y / scale) ? lit : 0x10);
+    }
+  }
+
+  // Wrap in zlib stored blocks of at most 64KB.
+  std::vector<uint8_t> zlib = { 0x78, 0x01 };
+  uint32_t adlerA = 1, adlerB = 0;
+  for (size_t offs = 0; offs < raw.size(); ) {
+    size_t len = raw.size() - offs < 0xffff ? raw.size() - offs : 0xffff;
+    bool last = offs + len == raw.size();
+    zlib.push_back(last ? 1 : 0);
+    zlib.push_back(len & 0xff);
+    zlib.push_back(len >> 8);
+    zlib.push_back(~len & 0xff);
+    zlib.push_back((~len >> 8) & 0xff);
+    for (size_t idx = offs; idx < offs + len; idx++) {
+      zlib.push_back(raw[idx]);
+      adlerA = (adlerA + raw[idx]) % 65521;
+      adlerB = (adlerB + adlerA) % 65521;
+    }
+    offs += len;
+  }
+  putBe32(zlib, (adlerB << 16) | adlerA);
+  putChunk(file, "IDAT", zlib);
+
+  putChunk(file, "IEND", std::vector<uint8_t>());
+  return fclose(file) == 0;
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+
+#include "hal.h"
+
+// -------------------------------------------------------------------------------------------------
+// A simulated SSD1306 which decodes the command and data stream sent over SPI into its own display
+// RAM, and counts the traffic.  The image it produces is as the watch wearer sees it, i.e., with
+// the segment remap and reversed COM scan from SSD1306::initialise() the RAM maps straight across.
+
+struct SimSSD1306 : HostSpiDevice {
+
+  struct Stats {
+    uint32_t transactions;
+    uint32_t commandBytes;
+    uint32_t dataBytes;
+    uint32_t writesWhileScrolling;    // Which corrupt the real display RAM.
+
+    uint32_t spiBytes() const { return commandBytes + dataBytes; }
+  };
+
+  SimSSD1306(uint8_t dataCommandPin, uint8_t chipSelectPin);
+
+  void pinWritten(uint8_t pin, uint8_t val) override;
+  void byteTransferred(uint8_t byte) override;
+
+  const Stats& stats() const { return m_stats; }
+  void resetStats() { m_stats = Stats(); }
+
+  bool isOn() const { return m_displayOn; }
+  uint8_t contrast() const { return m_contrast; }
+  uint8_t startLine() const { return m_startLine; }
+  bool isScrolling() const { return m_scrolling; }
+  uint8_t fadeMode() const { return m_fadeMode; }
+
+  // Whether the pixel at x, y is lit as the wearer sees it.
+  bool pixel(uint8_t x, uint8_t y) const;
+  uint16_t litPixels() const;
+
+  bool writePbm(const std::string& path) const;
+  bool writePng(const std::string& path, uint8_t scale) const;
+
+  private:
+
+  void command(uint8_t byte);
+  void data(uint8_t byte);
+  void scrollOneColumn(bool left);
+
+  uint8_t m_dataCommandPin;
+  uint8_t m_chipSelectPin;
+
+  bool m_selected = false;
+  bool m_isData = false;
+
+  // Command decoding: the opcode and arguments so far, and how many arguments it needs.
+  uint8_t m_cmd[8];
+  uint8_t m_cmdLen = 0;
+  uint8_t m_cmdArgs = 0;
+
+  uint8_t m_ram[8][128] = {};
+
+  uint8_t m_addrMode = 2;           // Page addressing after reset.
+  uint8_t m_colStart = 0, m_colEnd = 127;
+  uint8_t m_pageStart = 0, m_pageEnd = 7;
+  uint8_t m_col = 0, m_page = 0;
+
+  bool m_displayOn = false;
+  bool m_inverted = false;
+  bool m_entireOn = false;
+  bool m_segRemap = false;
+  bool m_comScanDec = false;
+  uint8_t m_startLine = 0;
+  uint8_t m_contrast = 0x7f;
+  uint8_t m_fadeMode = 0;
+
+  bool m_scrollSetUp = false;
+  bool m_scrolling = false;
+
+  Stats m_stats = {};
+};
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "Arduino.h"
+
+#include "sim-ssd1306.h"
+
+#include "../jitter.h"
+#include "../ssd1306.h"
+#include "../faces.h"
+#include "../power.h"
+#include "../trace.h"
+
+// =================================================================================================
+// Render a face into a simulated display, dumping each frame as an image and reporting what
+// it cost.
+// =================================================================================================
+
+namespace {
+
+  void usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -t HH:MM    time to show (default 10:08)\n"
+            "  -d MM-DD    date to show (default 10-17)\n"
+            "  -w N        day of week, Sunday is 1 (default 7)\n"
+            "  -b N        battery percentage (default 100)\n"
+            "  -c N        charging, 0 or 1 (default 0)\n"
+            "  -m N        hourly chime on, 0 or 1 (default 1)\n"
+            "  -f N        face to show, by its index in WatchFaces (default 0)\n"
+            "  -n N        number of frames to render (default 1)\n"
+            "  -i N        minutes to advance the time each frame (default 1)\n"
+            "  -a US       animate the face after the first frame, with this budget per frame\n"
+            "  -r N        jitter seed (default 1)\n"
+            "  -o PREFIX   write PREFIX-NNN.pbm and PREFIX-NNN.png for each frame\n"
+            "  -s N        PNG scale factor (default 4)\n",
+            prog);
+  }
+}
+
+int main(int argc, char** argv) {
+  int hour = 10, minute = 8, month = 10, day = 17, dayOfWeek = 7, batteryPc = 100;
+  int frames = 1, scale = 4, seed = 1, step = 1, animateUs = -1, face = 0, charging = 0, chimes = 1;
+  std::string prefix;
+
+  for (int argIdx = 1; argIdx < argc; argIdx++) {
+    const char* opt = argv[argIdx];
+    const char* val = argIdx + 1 < argc ? argv[argIdx + 1] : nullptr;
+    if (opt[0] != '-' || opt[1] == '\0' || opt[2] != '\0' || val == nullptr) {
+      usage(argv[0]);
+      return 1;
+    }
+    argIdx++;
+
+    bool ok = true;
+    switch (opt[1]) {
+      case 't': ok = sscanf(val, "%d:%d", &hour, &minute) == 2; break;
+      case 'd': ok = sscanf(val, "%d-%d", &month, &day) == 2; break;
+      case 'w': dayOfWeek = atoi(val); break;
+      case 'b': batteryPc = atoi(val); break;
+      case 'c': charging = atoi(val); break;
+      case 'm': chimes = atoi(val); break;
+      case 'f': face = atoi(val); ok = face >= 0 && face < WatchFaces::c_count; break;
+      case 'n': frames = atoi(val); break;
+      case 'i': step = atoi(val); break;
+      case 'a': animateUs = atoi(val); break;
+      case 'r': seed = atoi(val); break;
+      case 'o': prefix = val; break;
+      case 's': scale = atoi(val); break;
+      default: ok = false; break;
+    }
+    if (!ok) {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  SimSSD1306 sim(A3, A5);
+  hostAttachSpiDevice(&sim);
+
+  jitterSeed(seed);
+
+  SSD1306 display;
+  display.initialise();
+  display.clear();
+  printf("initialise: %u transactions, %u command bytes\n\n",
+         sim.stats().transactions, sim.stats().commandBytes);
+
+  printf("frame  transactions  cmd-bytes  data-bytes  spi-bytes  lines  set-pixels  lit-pixels"
+         "  counted  display-ua\n");
+  for (int frame = 0; frame < frames; frame++) {
+    sim.resetStats();
+    traceReset();
+
+    if (animateUs >= 0 && frame > 0) {
+      WatchFaces::animate(face, display, animateUs);
+    } else {
+      int frameMinutes = (hour * 60 + minute + frame * step) % (24 * 60);
+      FaceValues values = {
+        static_cast<uint8_t>(month), static_cast<uint8_t>(day),
+        static_cast<uint8_t>(frameMinutes / 60), static_cast<uint8_t>(frameMinutes % 60), 0,
+        static_cast<uint8_t>(dayOfWeek), static_cast<uint8_t>(batteryPc), charging != 0, chimes != 0
+      };
+      WatchFaces::draw(face, display, values);
+    }
+
+    const SimSSD1306::Stats& stats = sim.stats();
+    printf("%5d  %12u  %9u  %10u  %9u  %5u  %10u  %10u  %7u  %10u\n",
+           frame, stats.transactions, stats.commandBytes, stats.dataBytes, stats.spiBytes(),
+           traceCounter(TraceLines), traceCounter(TracePixels), sim.litPixels(),
+           display.litPixels(), displayCurrentUa(display.litPixels(), sim.contrast()));
+
+    if (!prefix.empty()) {
+      char suffix[16];
+      snprintf(suffix, sizeof(suffix), "-%03d", frame);
+      if (!sim.writePbm(prefix + suffix + ".pbm") || !sim.writePng(prefix + suffix + ".png", scale)) {
+        fprintf(stderr, "Failed to write %s%s images.\n", prefix.c_str(), suffix);
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+// =================================================================================================
@@ -0,0 +1,18 @@
+#include "icons.h"
+
+// -------------------------------------------------------------------------------------------------
+// A byte per column, LSB at the top.
+
+const uint8_t c_batteryIcon[c_batteryIconWidth] PROGMEM = {
+  0x7e, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x7e, 0x18,
+};
+
+const uint8_t c_chargingIcon[c_chargingIconWidth] PROGMEM = {
+  0x00, 0x08, 0x0c, 0x6e, 0x3b, 0x18, 0x08, 0x00,
+};
+
+const uint8_t c_bellIcon[c_bellIconWidth] PROGMEM = {
+  0x20, 0x30, 0x3e, 0xbf, 0xbf, 0x3e, 0x30, 0x20,
+};
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------------------------------------
+// Icons a page high, for SSD1306::drawSprite().
+
+// An empty battery, with room inside to fill columns 2 to 12 of rows 3 and 4.
+constexpr uint8_t c_batteryIconWidth = 16;
+extern const uint8_t c_batteryIcon[c_batteryIconWidth] PROGMEM;
+
+constexpr uint8_t c_chargingIconWidth = 8;
+extern const uint8_t c_chargingIcon[c_chargingIconWidth] PROGMEM;
+
+constexpr uint8_t c_bellIconWidth = 8;
+extern const uint8_t c_bellIcon[c_bellIconWidth] PROGMEM;
+
+// -------------------------------------------------------------------------------------------------
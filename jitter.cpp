@@ -0,0 +1,63 @@
+#include <Arduino.h>
+
+#include "jitter.h"
+
+#include "xorshift.h"
+
+// -------------------------------------------------------------------------------------------------
+
+uint16_t g_prng = 1;
+
+namespace {
+
+  uint16_t g_jitterSeed = 1;
+  uint8_t g_jitterFrame = 0;
+  uint8_t g_drawFrame = 0;      // The frame being drawn, normally this one.
+}
+
+const uint8_t c_jitterNoise[64] PROGMEM = {
+  0x0a, 0x08, 0x09, 0x05, 0x01, 0x05, 0x04, 0x0a, 0x09, 0x02, 0x05, 0x08, 0x04, 0x06, 0x05, 0x08,
+  0x00, 0x01, 0x04, 0x08, 0x0a, 0x02, 0x02, 0x05, 0x06, 0x08, 0x00, 0x01, 0x06, 0x02, 0x00, 0x08,
+  0x00, 0x02, 0x0a, 0x04, 0x01, 0x0a, 0x09, 0x00, 0x05, 0x06, 0x06, 0x08, 0x0a, 0x09, 0x06, 0x02,
+  0x09, 0x01, 0x01, 0x00, 0x0a, 0x09, 0x04, 0x05, 0x09, 0x00, 0x00, 0x06, 0x04, 0x02, 0x04, 0x01,
+};
+
+// -------------------------------------------------------------------------------------------------
+
+void jitterSeed(uint16_t seed) {
+  g_jitterSeed = seed;
+  g_jitterFrame = 0;
+  jitterRewind();
+}
+
+void jitterNextFrame() {
+  g_jitterFrame++;
+  jitterRewind();
+}
+
+// Put the PRNG back to where it was at the start of this frame.
+
+void jitterRewind() {
+  jitterRewind(g_jitterFrame, 0);
+}
+
+void jitterRewind(uint8_t frame, uint8_t stream) {
+  g_drawFrame = frame;
+  g_prng = g_jitterSeed ^ (static_cast<uint16_t>(frame) * 0x9e37u) ^ (static_cast<uint16_t>(stream) * 0x3c6fu);
+  if (g_prng == 0) {
+    g_prng = 1;
+  }
+  xorShift();
+}
+
+uint8_t jitterFrame() {
+  return g_jitterFrame;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t jitterVertexBase(int8_t x, int8_t y) {
+  return (g_drawFrame * 29) + (g_jitterSeed & 0xff) + (x * 13) + (y * 11);
+}
+
+// -------------------------------------------------------------------------------------------------
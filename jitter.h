@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+
+// -------------------------------------------------------------------------------------------------
+// The jitter which gives the faces their scribbly look.  Everything random comes from here and is
+// reset at the start of each frame from the seed and frame number, so any frame can be drawn again
+// exactly.
+
+void jitterSeed(uint16_t seed);
+void jitterNextFrame();
+void jitterRewind();
+uint8_t jitterFrame();
+
+// Rewind to how things drawn in an earlier frame were jittered, with a stream of their own so they
+// come out the same whatever's drawn before them.
+void jitterRewind(uint8_t frame, uint8_t stream);
+
+// -------------------------------------------------------------------------------------------------
+// Offsets of -1, 0 or 1 in each axis come from a small table of noise rather than modulo arithmetic.
+// Each entry packs dx + 1 in bits 1:0 and dy + 1 in bits 3:2.
+
+extern const uint8_t c_jitterNoise[64] PROGMEM;
+
+struct JitterOffset {
+  int8_t dx, dy;
+};
+
+inline JitterOffset jitterOffset(uint8_t index) {
+  uint8_t noise = pgm_read_byte(&(c_jitterNoise[index & 63]));
+  return { static_cast<int8_t>((noise & 0x03) - 1), static_cast<int8_t>(((noise >> 2) & 0x03) - 1) };
+}
+
+inline int8_t jitterNudge(uint8_t index) {
+  return jitterOffset(index).dx;
+}
+
+// The base noise index for the vertices of something drawn at x, y this frame.  Add a different odd
+// multiple per vertex so that each vertex gets its own offset, the same one every time it's used.
+uint8_t jitterVertexBase(int8_t x, int8_t y);
+
+// -------------------------------------------------------------------------------------------------
@@ -2,347 +2,297 @@
 
 #include "lines.h"
 
+#include "jitter.h"
 #include "ssd1306.h"
 #include "xorshift.h"
 
 // -------------------------------------------------------------------------------------------------
 
-void drawLine(SSD1306& display, int8_t ax, int8_t ay, int8_t bx, int8_t by, bool jitter) {
+void drawLine(SSD1306& display, int8_t ax, int8_t ay, int8_t bx, int8_t by, bool jitter, uint8_t width /*= 1*/) {
+  // Widen first so jitter can't wrap a coordinate at the edge of the int8_t range.
+  int16_t x0 = ax, y0 = ay, x1 = bx, y1 = by;
   if (jitter) {
     uint16_t rand = xorShift();
-    ax += ((rand >> 0) % 3) - 1;
-    ay += ((rand >> 2) % 3) - 1;
-    bx += ((rand >> 4) % 3) - 1;
-    by += ((rand >> 6) % 3) - 1;
+    JitterOffset offsA = jitterOffset(rand);
+    JitterOffset offsB = jitterOffset(rand >> 8);
+    x0 += offsA.dx;
+    y0 += offsA.dy;
+    x1 += offsB.dx;
+    y1 += offsB.dy;
   }
 
-  int8_t dx = abs(bx - ax);
-  int8_t sx = ax < bx ? 1 : -1;
-
-  int8_t dy = abs(by - ay);
-  int8_t sy = ay < by ? 1 : -1;
-
-  int8_t err = (dx > dy ? dx : -dy) / 2;
-
-  // The longest line we can possibly draw on a 128x64 screen is 143.108.  To be sure we don't loop
-  // forever accidentally we'll max out there.
-  for (int8_t _ = 0; _ < 144; _++) {
-    display.setPixel(ax, ay);
-
-    if (ax == bx && ay == by) { break; }
-
-    int8_t err2 = err;
-    if (err2 > -dx) { err -= dy; ax += sx; }
-    if (err2 <  dy) { err += dx; ay += sy; }
-  }
+  display.drawLine(x0, y0, x1, y1, width);
 }
 
 // -------------------------------------------------------------------------------------------------
-
-void drawZero(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  top,    left,  bottom, jitter);
-  drawLine(display, right, top,    right, bottom, jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawOne(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(left, right);
-  drawLine(display, mid, top, mid, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawTwo(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  mid,    right, mid,    jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-  drawLine(display, right, top,    right, mid,    jitter);
-  drawLine(display, left,  mid,    left,  bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawThree(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  mid,    right, mid,    jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-  drawLine(display, right, top,    right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawFour(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top, left,  mid,    jitter);
-  drawLine(display, right, top, right, bottom, jitter);
-  drawLine(display, left,  mid, right, mid,    jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawFive(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  mid,    right, mid,    jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-  drawLine(display, left,  top,    left,  mid,    jitter);
-  drawLine(display, right, mid,    right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawSix(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  mid,    right, mid,    jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-  drawLine(display, left,  top,    left,  bottom, jitter);
-  drawLine(display, right, mid,    right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawSeven(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawLine(display, left,  top, right, top,    jitter);
-  drawLine(display, right, top, right, bottom, jitter);
+// The stroke font.  Each glyph is a polyline over a 5x5 grid spanning its box -- the edges, middle
+// and quarter points across and down -- packed one point per byte:
+//
+//   bit 7    - move to the point rather than drawing a line to it
+//   bits 6:4 - column, 0 (left) to 4 (right)
+//   bits 2:0 - row, 0 (top) to 4 (bottom)
+//
+// and terminated by c_glyphEnd.
+//
+// When jittered each grid point is nudged once and every stroke meeting there shares the nudge, so
+// the corners stay joined.
+
+namespace {
+
+  constexpr uint8_t c_glyphMove = 0x80;
+  constexpr uint8_t c_glyphEnd = 0xff;
+
+  // Grid columns and rows.
+  constexpr uint8_t L = 0, LQ = 1, C = 2, RQ = 3, R = 4;
+  constexpr uint8_t T = 0, TQ = 1, M = 2, BQ = 3, B = 4;
+
+  constexpr uint8_t mv(uint8_t col, uint8_t row) { return c_glyphMove | (col << 4) | row; }
+  constexpr uint8_t to(uint8_t col, uint8_t row) { return (col << 4) | row; }
+
+  constexpr uint8_t glyphSpace[]   PROGMEM = { c_glyphEnd };
+  constexpr uint8_t glyphBang[]    PROGMEM = { mv(C, T), to(C, BQ), mv(C, B), to(C, B), c_glyphEnd };
+  constexpr uint8_t glyphQuotes[]  PROGMEM = { mv(LQ, T), to(LQ, TQ), mv(RQ, T), to(RQ, TQ), c_glyphEnd };
+  constexpr uint8_t glyphHash[]    PROGMEM = { mv(LQ, T), to(LQ, B), mv(RQ, T), to(RQ, B),
+                                               mv(L, TQ), to(R, TQ), mv(L, BQ), to(R, BQ), c_glyphEnd };
+  constexpr uint8_t glyphDollar[]  PROGMEM = { mv(R, TQ), to(L, TQ), to(L, M), to(R, M), to(R, BQ),
+                                               to(L, BQ), mv(C, T), to(C, B), c_glyphEnd };
+  constexpr uint8_t glyphPercent[] PROGMEM = { mv(L, T), to(LQ, TQ), mv(LQ, T), to(L, TQ), mv(R, T),
+                                               to(L, B), mv(RQ, BQ), to(R, B), mv(R, BQ), to(RQ, B),
+                                               c_glyphEnd };
+  constexpr uint8_t glyphQuote[]   PROGMEM = { mv(C, T), to(C, TQ), c_glyphEnd };
+  constexpr uint8_t glyphLParen[]  PROGMEM = { mv(RQ, T), to(LQ, TQ), to(LQ, BQ), to(RQ, B), c_glyphEnd };
+  constexpr uint8_t glyphRParen[]  PROGMEM = { mv(LQ, T), to(RQ, TQ), to(RQ, BQ), to(LQ, B), c_glyphEnd };
+  constexpr uint8_t glyphStar[]    PROGMEM = { mv(LQ, TQ), to(RQ, BQ), mv(RQ, TQ), to(LQ, BQ),
+                                               mv(C, TQ), to(C, BQ), c_glyphEnd };
+  constexpr uint8_t glyphPlus[]    PROGMEM = { mv(C, TQ), to(C, BQ), mv(LQ, M), to(RQ, M), c_glyphEnd };
+  constexpr uint8_t glyphComma[]   PROGMEM = { mv(C, BQ), to(LQ, B), c_glyphEnd };
+  constexpr uint8_t glyphMinus[]   PROGMEM = { mv(LQ, M), to(RQ, M), c_glyphEnd };
+  constexpr uint8_t glyphPeriod[]  PROGMEM = { mv(C, B), to(C, B), c_glyphEnd };
+  constexpr uint8_t glyphSlash[]   PROGMEM = { mv(R, T), to(L, B), c_glyphEnd };
+
+  constexpr uint8_t glyph0[] PROGMEM = { mv(L, T), to(R, T), to(R, B), to(L, B), to(L, T), c_glyphEnd };
+  constexpr uint8_t glyph1[] PROGMEM = { mv(C, T), to(C, B), c_glyphEnd };
+  constexpr uint8_t glyph2[] PROGMEM = { mv(L, T), to(R, T), to(R, M), to(L, M), to(L, B), to(R, B),
+                                         c_glyphEnd };
+  constexpr uint8_t glyph3[] PROGMEM = { mv(L, T), to(R, T), to(R, B), to(L, B), mv(L, M), to(R, M),
+                                         c_glyphEnd };
+  constexpr uint8_t glyph4[] PROGMEM = { mv(L, T), to(L, M), to(R, M), mv(R, T), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyph5[] PROGMEM = { mv(R, T), to(L, T), to(L, M), to(R, M), to(R, B), to(L, B),
+                                         c_glyphEnd };
+  constexpr uint8_t glyph6[] PROGMEM = { mv(R, T), to(L, T), to(L, B), to(R, B), to(R, M), to(L, M),
+                                         c_glyphEnd };
+  constexpr uint8_t glyph7[] PROGMEM = { mv(L, T), to(R, T), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyph8[] PROGMEM = { mv(L, T), to(R, T), to(R, B), to(L, B), to(L, T), mv(L, M),
+                                         to(R, M), c_glyphEnd };
+  constexpr uint8_t glyph9[] PROGMEM = { mv(R, M), to(L, M), to(L, T), to(R, T), to(R, B), to(L, B),
+                                         c_glyphEnd };
+
+  constexpr uint8_t glyphColon[]   PROGMEM = { mv(C, TQ), to(C, TQ), mv(C, BQ), to(C, BQ), c_glyphEnd };
+  constexpr uint8_t glyphSemi[]    PROGMEM = { mv(C, TQ), to(C, TQ), mv(C, BQ), to(LQ, B), c_glyphEnd };
+  constexpr uint8_t glyphLess[]    PROGMEM = { mv(R, T), to(L, M), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyphEquals[]  PROGMEM = { mv(L, TQ), to(R, TQ), mv(L, BQ), to(R, BQ), c_glyphEnd };
+  constexpr uint8_t glyphGreater[] PROGMEM = { mv(L, T), to(R, M), to(L, B), c_glyphEnd };
+  constexpr uint8_t glyphQuery[]   PROGMEM = { mv(L, T), to(R, T), to(R, M), to(C, M), to(C, BQ),
+                                               mv(C, B), to(C, B), c_glyphEnd };
+
+  constexpr uint8_t glyphA[] PROGMEM = { mv(L, B), to(L, T), to(R, T), to(R, B), mv(L, M), to(R, M),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphB[] PROGMEM = { mv(L, T), to(L, B), to(R, B), to(R, M), to(L, M), mv(L, T),
+                                         to(RQ, T), to(RQ, M), c_glyphEnd };
+  constexpr uint8_t glyphC[] PROGMEM = { mv(R, T), to(L, T), to(L, B), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyphD[] PROGMEM = { mv(C, T), to(L, T), to(L, B), to(R, B), to(R, M), to(C, T),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphE[] PROGMEM = { mv(R, T), to(L, T), to(L, B), to(R, B), mv(L, M), to(R, M),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphF[] PROGMEM = { mv(R, T), to(L, T), to(L, B), mv(L, M), to(R, M), c_glyphEnd };
+  constexpr uint8_t glyphG[] PROGMEM = { mv(R, T), to(L, T), to(L, B), to(R, B), to(R, M), to(C, M),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphH[] PROGMEM = { mv(L, T), to(L, B), mv(R, T), to(R, B), mv(L, M), to(R, M),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphJ[] PROGMEM = { mv(R, T), to(R, B), to(L, B), to(L, M), c_glyphEnd };
+  constexpr uint8_t glyphK[] PROGMEM = { mv(L, T), to(L, B), mv(R, T), to(L, M), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyphL[] PROGMEM = { mv(L, T), to(L, B), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyphM[] PROGMEM = { mv(L, B), to(L, T), to(R, T), to(R, B), mv(C, T), to(C, B),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphN[] PROGMEM = { mv(L, B), to(L, T), to(R, B), to(R, T), c_glyphEnd };
+  constexpr uint8_t glyphP[] PROGMEM = { mv(L, B), to(L, T), to(R, T), to(R, M), to(L, M), c_glyphEnd };
+  constexpr uint8_t glyphQ[] PROGMEM = { mv(L, T), to(R, T), to(R, B), to(L, B), to(L, T), mv(C, M),
+                                         to(R, B), c_glyphEnd };
+  constexpr uint8_t glyphR[] PROGMEM = { mv(L, B), to(L, T), to(R, T), to(R, M), to(L, M), to(R, B),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphT[] PROGMEM = { mv(L, T), to(R, T), mv(C, T), to(C, B), c_glyphEnd };
+  constexpr uint8_t glyphU[] PROGMEM = { mv(L, T), to(L, B), to(R, B), to(R, T), c_glyphEnd };
+  constexpr uint8_t glyphV[] PROGMEM = { mv(L, T), to(C, B), to(R, T), c_glyphEnd };
+  constexpr uint8_t glyphW[] PROGMEM = { mv(L, T), to(L, B), to(R, B), to(R, T), mv(C, T), to(C, B),
+                                         c_glyphEnd };
+  constexpr uint8_t glyphX[] PROGMEM = { mv(L, T), to(R, B), mv(R, T), to(L, B), c_glyphEnd };
+  constexpr uint8_t glyphY[] PROGMEM = { mv(L, T), to(C, M), to(R, T), mv(C, M), to(C, B), c_glyphEnd };
+  constexpr uint8_t glyphZ[] PROGMEM = { mv(L, T), to(R, T), to(L, B), to(R, B), c_glyphEnd };
+
+  constexpr uint8_t glyphLSquare[]   PROGMEM = { mv(RQ, T), to(LQ, T), to(LQ, B), to(RQ, B), c_glyphEnd };
+  constexpr uint8_t glyphBackslash[] PROGMEM = { mv(L, T), to(R, B), c_glyphEnd };
+  constexpr uint8_t glyphRSquare[]   PROGMEM = { mv(LQ, T), to(RQ, T), to(RQ, B), to(LQ, B), c_glyphEnd };
+  constexpr uint8_t glyphCaret[]     PROGMEM = { mv(L, M), to(C, T), to(R, M), c_glyphEnd };
+  constexpr uint8_t glyphUnder[]     PROGMEM = { mv(L, B), to(R, B), c_glyphEnd };
+
+  // Drawn without jitter for anything we don't have a glyph for.
+  constexpr uint8_t glyphDenied[] PROGMEM = { mv(L, T), to(R, T), to(R, B), to(L, B), to(L, T),
+                                              to(R, B), mv(R, T), to(L, B), c_glyphEnd };
+
+  // ' ' to '_', lower case is drawn as upper case.  I and O share 1 and 0, S shares 5.
+  constexpr const uint8_t* const glyphs[64] PROGMEM = {
+    glyphSpace, glyphBang, glyphQuotes, glyphHash, glyphDollar, glyphPercent, nullptr, glyphQuote,
+    glyphLParen, glyphRParen, glyphStar, glyphPlus, glyphComma, glyphMinus, glyphPeriod, glyphSlash,
+    glyph0, glyph1, glyph2, glyph3, glyph4, glyph5, glyph6, glyph7,
+    glyph8, glyph9, glyphColon, glyphSemi, glyphLess, glyphEquals, glyphGreater, glyphQuery,
+    nullptr, glyphA, glyphB, glyphC, glyphD, glyphE, glyphF, glyphG,
+    glyphH, glyph1, glyphJ, glyphK, glyphL, glyphM, glyphN, glyph0,
+    glyphP, glyphQ, glyphR, glyph5, glyphT, glyphU, glyphV, glyphW,
+    glyphX, glyphY, glyphZ, glyphLSquare, glyphBackslash, glyphRSquare, glyphCaret, glyphUnder,
+  };
 }
 
 // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
 
-void drawEight(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  mid,    right, mid,    jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-  drawLine(display, left,  top,    left,  bottom, jitter);
-  drawLine(display, right, top,    right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawNine(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top,    right, top,    jitter);
-  drawLine(display, left,  mid,    right, mid,    jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-  drawLine(display, right, top,    right, bottom, jitter);
-  drawLine(display, left,  top,    left,  mid,    jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawNum(SSD1306& display, int8_t digit, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  switch (digit) {
-    case 0: drawZero(display,  left, top, right, bottom, jitter); break;
-    case 1: drawOne(display,   left, top, right, bottom, jitter); break;
-    case 2: drawTwo(display,   left, top, right, bottom, jitter); break;
-    case 3: drawThree(display, left, top, right, bottom, jitter); break;
-    case 4: drawFour(display,  left, top, right, bottom, jitter); break;
-    case 5: drawFive(display,  left, top, right, bottom, jitter); break;
-    case 6: drawSix(display,   left, top, right, bottom, jitter); break;
-    case 7: drawSeven(display, left, top, right, bottom, jitter); break;
-    case 8: drawEight(display, left, top, right, bottom, jitter); break;
-    case 9: drawNine(display,  left, top, right, bottom, jitter); break;
+void drawGlyph(SSD1306& display, char glyph, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter,
+               uint8_t width /*= 1*/) {
+  if (glyph >= 'a' && glyph <= 'z') {
+    glyph -= 'a' - 'A';
   }
-}
-
-// -------------------------------------------------------------------------------------------------
-
-void drawDenied(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool ) {
-  drawLine(display, left,  top,    right, top,    false);
-  drawLine(display, left,  bottom, right, bottom, false);
-  drawLine(display, left,  top,    left,  bottom, false);
-  drawLine(display, right, top,    right, bottom, false);
-
-  drawLine(display, left, top, right, bottom, false);
-  drawLine(display, right, top, left, bottom, false);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawA(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top, right, top,    jitter);
-  drawLine(display, left,  top, left,  bottom, jitter);
-  drawLine(display, right, top, right, bottom, jitter);
-  drawLine(display, left,  mid, right, mid,    jitter);
-}
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawD(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t midW = getMid(left, right);
-  int8_t midH = getMid(top, bottom);
-  drawLine(display, left,  top,    midW,  top,    jitter);
-  drawLine(display, left,  top,    left,  bottom, jitter);
-  drawLine(display, midW,  top,    right, midH,   jitter);
-  drawLine(display, right, midH,   right, bottom, jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+  const uint8_t* strokes = nullptr;
+  if (glyph >= ' ' && glyph <= '_') {
+    strokes = static_cast<const uint8_t*>(pgm_read_ptr(&(glyphs[glyph - ' '])));
+  }
+  if (strokes == nullptr) {
+    strokes = glyphDenied;
+    jitter = false;
+  }
 
-void drawE(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left, top,    left,  bottom, jitter);
-  drawLine(display, left, top,    right, top,    jitter);
-  drawLine(display, left, mid,    right, mid,    jitter);
-  drawLine(display, left, bottom, right, bottom, jitter);
+  // The grid positions within the box.
+  int8_t quarterW = (right - left) / 4;
+  int8_t quarterH = (bottom - top) / 4;
+  int8_t cols[5] = { left, static_cast<int8_t>(left + quarterW), getMid(left, right),
+                     static_cast<int8_t>(right - quarterW), right };
+  int8_t rows[5] = { top, static_cast<int8_t>(top + quarterH), getMid(top, bottom),
+                     static_cast<int8_t>(bottom - quarterH), bottom };
+
+  uint8_t noiseBase = jitterVertexBase(left, top);
+
+  int16_t penX = left;
+  int16_t penY = top;
+  for (;;) {
+    uint8_t point = pgm_read_byte(strokes++);
+    if (point == c_glyphEnd) {
+      break;
+    }
+
+    uint8_t col = (point >> 4) & 0x07;
+    uint8_t row = point & 0x07;
+    int16_t x = cols[col];
+    int16_t y = rows[row];
+    uint8_t strokeWidth = width;
+    if (jitter) {
+      uint8_t noise = noiseBase + (col * 5 + row) * 7;
+      JitterOffset offs = jitterOffset(noise);
+      x += offs.dx;
+      y += offs.dy;
+      if (width > 1) {
+        strokeWidth += jitterNudge(noise + 3);
+      }
+    }
+
+    if ((point & c_glyphMove) == 0) {
+      display.drawLine(penX, penY, x, y, strokeWidth);
+    }
+    penX = x;
+    penY = y;
+  }
 }
 
 // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
 
-void drawF(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left, top, left,  bottom, jitter);
-  drawLine(display, left, top, right, top,    jitter);
-  drawLine(display, left, mid, right, mid,    jitter);
+void drawNum(SSD1306& display, int8_t digit, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter,
+             uint8_t width /*= 1*/) {
+  if (digit >= 0 && digit <= 9) {
+    drawGlyph(display, '0' + digit, left, top, right, bottom, jitter, width);
+  }
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawH(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top, left,  bottom, jitter);
-  drawLine(display, right, top, right, bottom, jitter);
-  drawLine(display, left,  mid, right, mid,    jitter);
+void drawLetter(SSD1306& display, char letter, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter,
+                uint8_t width /*= 1*/) {
+  drawGlyph(display, letter, left, top, right, bottom, jitter, width);
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawI(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawOne(display, left, top, right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// -------------------------------------------------------------------------------------------------
 
-void drawM(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
+void drawColon(SSD1306& display, int8_t radius, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter,
+               uint8_t width /*= 1*/) {
+  int8_t height33 = (bottom - top) / 3;
   int8_t mid = getMid(left, right);
-  drawLine(display, left,  top, right, top,    jitter);
-  drawLine(display, left,  top, left,  bottom, jitter);
-  drawLine(display, right, top, right, bottom, jitter);
-  drawLine(display, mid,   top, mid,   bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
 
-void drawN(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawLine(display, left,  top, left,  bottom, jitter);
-  drawLine(display, right, top, right, bottom, jitter);
-  drawLine(display, left,  top, right, bottom, jitter);
+  auto drawDot = width > 1 ? fillCircle : drawCircle;
+  drawDot(display, mid, top + height33 - radius, radius, jitter);
+  drawDot(display, mid, bottom - height33 + radius, radius, jitter);
 }
 
 // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
 
-void drawO(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawZero(display, left, top, right, bottom, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawR(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(top, bottom);
-  drawLine(display, left,  top, left,  bottom, jitter);
-  drawLine(display, left,  top, right, top,    jitter);
-  drawLine(display, right, top, right, mid,    jitter);
-  drawLine(display, left,  mid, right, mid,    jitter);
-  drawLine(display, left,  mid, right, bottom, jitter);
+void drawPercent(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
+  drawGlyph(display, '%', left, top, right, bottom, jitter);
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawS(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawFive(display, left, top, right, bottom, jitter);
+// -------------------------------------------------------------------------------------------------
+// Curves.  Jittering nudges the centre and radius, or the corners of a rectangle, by up to a pixel.
+
+namespace {
+
+  struct JitteredCircle {
+    int16_t cx, cy, radius;
+  };
+
+  JitteredCircle jitterCircle(int8_t cx, int8_t cy, int8_t radius, bool jitter) {
+    JitteredCircle circle = { cx, cy, radius };
+    if (jitter) {
+      uint16_t rand = xorShift();
+      JitterOffset offs = jitterOffset(rand);
+      circle.cx += offs.dx;
+      circle.cy += offs.dy;
+      circle.radius += jitterNudge(rand >> 8);
+    }
+    return circle;
+  }
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawT(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(left, right);
-  drawLine(display, left, top, right, top,    jitter);
-  drawLine(display, mid,  top, mid,   bottom, jitter);
+void drawCircle(SSD1306& display, int8_t cx, int8_t cy, int8_t radius, bool jitter) {
+  JitteredCircle circle = jitterCircle(cx, cy, radius, jitter);
+  display.drawCircle(circle.cx, circle.cy, circle.radius);
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawU(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  drawLine(display, left,  top,    left,  bottom, jitter);
-  drawLine(display, right, top,    right, bottom, jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
+void fillCircle(SSD1306& display, int8_t cx, int8_t cy, int8_t radius, bool jitter) {
+  // A dot looks better moved than resized.
+  JitteredCircle circle = jitterCircle(cx, cy, radius, jitter);
+  display.fillCircle(circle.cx, circle.cy, radius);
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawW(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t mid = getMid(left, right);
-  drawLine(display, left,  top,    left,  bottom, jitter);
-  drawLine(display, mid,   top,    mid,   bottom, jitter);
-  drawLine(display, right, top,    right, bottom, jitter);
-  drawLine(display, left,  bottom, right, bottom, jitter);
+void drawArc(SSD1306& display, int8_t cx, int8_t cy, int8_t radius, uint8_t startAngle, uint8_t endAngle, bool jitter) {
+  JitteredCircle circle = jitterCircle(cx, cy, radius, jitter);
+  display.drawArc(circle.cx, circle.cy, circle.radius, startAngle, endAngle);
 }
 
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-// sun, mon, tue, wed, thu, fri, sat -- sunmotewdhfria
-
-void drawLetter(SSD1306& display, char letter, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  switch (letter) {
-    case 'a': drawA(display, left, top, right, bottom, jitter);      break;
-    case 'd': drawD(display, left, top, right, bottom, jitter);      break;
-    case 'e': drawE(display, left, top, right, bottom, jitter);      break;
-    case 'f': drawF(display, left, top, right, bottom, jitter);      break;
-    case 'h': drawH(display, left, top, right, bottom, jitter);      break;
-    case 'i': drawI(display, left, top, right, bottom, jitter);      break;
-    case 'm': drawM(display, left, top, right, bottom, jitter);      break;
-    case 'n': drawN(display, left, top, right, bottom, jitter);      break;
-    case 'o': drawO(display, left, top, right, bottom, jitter);      break;
-    case 'r': drawR(display, left, top, right, bottom, jitter);      break;
-    case 's': drawS(display, left, top, right, bottom, jitter);      break;
-    case 't': drawT(display, left, top, right, bottom, jitter);      break;
-    case 'u': drawU(display, left, top, right, bottom, jitter);      break;
-    case 'w': drawW(display, left, top, right, bottom, jitter);      break;
-
-    default:  drawDenied(display, left, top, right, bottom, jitter); break;
+void drawRoundRect(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t radius, bool jitter) {
+  int16_t x0 = left, y0 = top, x1 = right, y1 = bottom;
+  if (jitter) {
+    uint16_t rand = xorShift();
+    JitterOffset offsA = jitterOffset(rand);
+    JitterOffset offsB = jitterOffset(rand >> 8);
+    x0 += offsA.dx;
+    y0 += offsA.dy;
+    x1 += offsB.dx;
+    y1 += offsB.dy;
   }
-}
-
-// -------------------------------------------------------------------------------------------------
-
-void drawColon(SSD1306& display, int8_t radius, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t height33 = (bottom - top) / 3;
-  int8_t mid = getMid(left, right);
-  int8_t diameter = radius * 2;
-
-  // Horizontal lines.
-  drawLine(display, mid - radius, top + height33 - diameter,    mid + radius, top + height33 - diameter,    jitter);
-  drawLine(display, mid - radius, top + height33,               mid + radius, top + height33,               jitter);
-  drawLine(display, mid - radius, bottom - height33,            mid + radius, bottom - height33,            jitter);
-  drawLine(display, mid - radius, bottom - height33 + diameter, mid + radius, bottom - height33 + diameter, jitter);
-
-  // Vertical lines.
-  drawLine(display, mid - radius, top + height33 - diameter, mid - radius, top + height33,       jitter);
-  drawLine(display, mid + radius, top + height33 - diameter, mid + radius, top + height33,       jitter);
-  drawLine(display, mid - radius, bottom - height33, mid - radius, bottom - height33 + diameter, jitter);
-  drawLine(display, mid + radius, bottom - height33, mid + radius, bottom - height33 + diameter, jitter);
-}
-
-// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
-
-void drawPercent(SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter) {
-  int8_t dotWidth = (right - left) / 4;
-  int8_t dotHeight = (bottom - top) / 4;
-
-  drawLine(display, left, top, left + dotWidth, top + dotHeight, jitter);
-  drawLine(display, left + dotWidth, top, left, top + dotHeight, jitter);
-
-  drawLine(display, right, top, left, bottom, jitter);
 
-  drawLine(display, right - dotWidth, bottom - dotHeight, right, bottom, jitter);
-  drawLine(display, right, bottom - dotHeight, right - dotWidth, bottom, jitter);
+  display.drawRoundRect(x0, y0, x1, y1, radius);
 }
 
 // -------------------------------------------------------------------------------------------------
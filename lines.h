@@ -1,11 +1,19 @@
 #pragma once
 
-void drawLine(struct SSD1306& display, int8_t ax, int8_t ay, int8_t bx, int8_t by, bool jitter);
-void drawNum(struct SSD1306& display, int8_t digit, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter);
-void drawLetter(struct SSD1306& display, char letter, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter);
-void drawColon(struct SSD1306& display, int8_t radius, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter);
+// Strokes may be wider than a pixel.  Jittered glyphs vary the width by a pixel along the strokes,
+// like a pen, and wide colons have filled dots.
+void drawLine(struct SSD1306& display, int8_t ax, int8_t ay, int8_t bx, int8_t by, bool jitter, uint8_t width = 1);
+void drawGlyph(struct SSD1306& display, char glyph, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter, uint8_t width = 1);
+void drawNum(struct SSD1306& display, int8_t digit, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter, uint8_t width = 1);
+void drawLetter(struct SSD1306& display, char letter, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter, uint8_t width = 1);
+void drawColon(struct SSD1306& display, int8_t radius, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter, uint8_t width = 1);
 void drawPercent(struct SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, bool jitter);
 
+void drawCircle(struct SSD1306& display, int8_t cx, int8_t cy, int8_t radius, bool jitter);
+void fillCircle(struct SSD1306& display, int8_t cx, int8_t cy, int8_t radius, bool jitter);
+void drawArc(struct SSD1306& display, int8_t cx, int8_t cy, int8_t radius, uint8_t startAngle, uint8_t endAngle, bool jitter);
+void drawRoundRect(struct SSD1306& display, int8_t left, int8_t top, int8_t right, int8_t bottom, int8_t radius, bool jitter);
+
 template <typename T> T getMid(T a, T b) {
   return a + ((b - a) / 2);
 }
@@ -0,0 +1,203 @@
+#include <Arduino.h>
+
+#include <Wire.h>
+
+#include "motion.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  // INT6.  The pin is driven low and latched until the status is read.
+  constexpr int8_t c_imuIntPin = 7;
+
+  constexpr uint8_t c_imuAddress = 0x68;
+
+  // Registers.
+  constexpr uint8_t c_regSampleRateDiv = 0x19;
+  constexpr uint8_t c_regConfig = 0x1a;
+  constexpr uint8_t c_regAccelConfig = 0x1c;
+  constexpr uint8_t c_regMotionThreshold = 0x1f;
+  constexpr uint8_t c_regMotionDuration = 0x20;
+  constexpr uint8_t c_regFifoEnable = 0x23;
+  constexpr uint8_t c_regIntPinConfig = 0x37;
+  constexpr uint8_t c_regIntEnable = 0x38;
+  constexpr uint8_t c_regIntStatus = 0x3a;
+  constexpr uint8_t c_regAccelOut = 0x3b;
+  constexpr uint8_t c_regUserControl = 0x6a;
+  constexpr uint8_t c_regPowerManagement1 = 0x6b;
+  constexpr uint8_t c_regPowerManagement2 = 0x6c;
+  constexpr uint8_t c_regFifoCountHigh = 0x72;
+  constexpr uint8_t c_regFifoData = 0x74;
+
+  // Register bits.
+  constexpr uint8_t c_intActiveLow = 0x80, c_intLatch = 0x20, c_intClearOnRead = 0x10;
+  constexpr uint8_t c_intMotion = 0x40, c_intFifoOverflow = 0x10;
+  constexpr uint8_t c_userFifoEnable = 0x40, c_userFifoReset = 0x04;
+  constexpr uint8_t c_fifoAccel = 0x08;
+  constexpr uint8_t c_powerReset = 0x80, c_powerCycle = 0x20, c_powerTempDisable = 0x08;
+  constexpr uint8_t c_powerWake5Hz = 0x40, c_powerGyroStandby = 0x07;
+  constexpr uint8_t c_accelHpf063Hz = 0x04;
+
+  // Motion is the acceleration on any axis, high pass filtered to leave only changes, passing this
+  // many 2mg steps for more than this many samples.  A raise passes it for two or three samples,
+  // walking and typing for one at most, see host/traces.
+  constexpr uint8_t c_motionThreshold = 100;
+  constexpr uint8_t c_motionDuration = 1;
+
+  // Samples are read out in bursts of at most this many, to fit the Wire library's 32 byte buffer.
+  constexpr uint8_t c_sampleBytes = 6;
+  constexpr uint8_t c_samplesPerRead = 32 / c_sampleBytes;
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+  // Raise detection.  The Z axis is out of the face, in 1/64ths of a g.  A raise is the face turning
+  // from facing away or sideways to facing up within a short window, and the next can't be seen
+  // until the face has been turned away again.
+
+  constexpr int8_t c_faceAwayZ = 19;      // 0.3g
+  constexpr int8_t c_faceUpZ = 48;        // 0.75g
+  constexpr int8_t c_maxTiltX = 32;       // 0.5g, so the face isn't tipped too far along the arm.
+  constexpr uint8_t c_raiseSamples = 8;   // 1.6s at 5Hz.
+
+  bool g_raiseArmed = true;
+  uint8_t g_samplesSinceAway = 0xff;
+  bool g_faceUp = false;        // As last seen.
+
+  bool detectRaise(int8_t x, int8_t z) {
+    g_faceUp = z >= c_faceUpZ;
+    if (z <= c_faceAwayZ) {
+      g_samplesSinceAway = 0;
+      g_raiseArmed = true;
+      return false;
+    }
+    if (g_samplesSinceAway < 0xff) {
+      g_samplesSinceAway++;
+    }
+
+    if (g_raiseArmed && z >= c_faceUpZ && abs(x) <= c_maxTiltX &&
+        g_samplesSinceAway <= c_raiseSamples) {
+      g_raiseArmed = false;
+      return true;
+    }
+    return false;
+  }
+
+  // -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+  volatile bool g_motionPending = false;
+
+  void imuIsr() {
+    // The pin stays low until the status is read, which can't be done here, so stop listening
+    // until it has been.
+    detachInterrupt(digitalPinToInterrupt(c_imuIntPin));
+    g_motionPending = true;
+  }
+
+  void attachImuIsr() {
+    // Level triggered so it wakes us from power down.
+    attachInterrupt(digitalPinToInterrupt(c_imuIntPin), imuIsr, LOW);
+  }
+
+  void writeRegister(uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(c_imuAddress);
+    Wire.write(reg);
+    Wire.write(value);
+    Wire.endTransmission();
+  }
+
+  uint8_t readRegisters(uint8_t reg, uint8_t len) {
+    Wire.beginTransmission(c_imuAddress);
+    Wire.write(reg);
+    Wire.endTransmission(false);
+    return Wire.requestFrom(c_imuAddress, len);
+  }
+
+  uint8_t readRegister(uint8_t reg) {
+    readRegisters(reg, 1);
+    return Wire.read();
+  }
+
+  // The high byte of a big endian 16 bit value, which at +/-2g is in 1/64ths of a g.
+  int8_t readAxis() {
+    int8_t high = Wire.read();
+    Wire.read();
+    return high;
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void motionInitialise() {
+  pinMode(c_imuIntPin, INPUT_PULLUP);
+
+  writeRegister(c_regPowerManagement1, c_powerReset);
+  delay(100);
+
+  // The accelerometer alone at +/-2g, with the gyros in standby, waking itself 5 times a second to
+  // take a sample, log it to the FIFO and pass it through the high pass filter motion is detected
+  // on.  The filter's reset mode holds its output at zero, so a cutoff has to be set.
+  writeRegister(c_regConfig, 0);
+  writeRegister(c_regAccelConfig, c_accelHpf063Hz);
+  writeRegister(c_regSampleRateDiv, 0);
+  writeRegister(c_regMotionThreshold, c_motionThreshold);
+  writeRegister(c_regMotionDuration, c_motionDuration);
+  writeRegister(c_regIntPinConfig, c_intActiveLow | c_intLatch | c_intClearOnRead);
+  writeRegister(c_regIntEnable, c_intMotion);
+  writeRegister(c_regUserControl, c_userFifoEnable | c_userFifoReset);
+  writeRegister(c_regFifoEnable, c_fifoAccel);
+  writeRegister(c_regPowerManagement2, c_powerWake5Hz | c_powerGyroStandby);
+  writeRegister(c_regPowerManagement1, c_powerCycle | c_powerTempDisable);
+
+  attachImuIsr();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool motionPending() {
+  return g_motionPending;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+bool motionCheckRaise() {
+  // Reading the status releases the pin.
+  uint8_t status = readRegister(c_regIntStatus);
+  g_motionPending = false;
+  attachImuIsr();
+
+  if ((status & c_intFifoOverflow) != 0) {
+    // It's been still for long enough to fill the FIFO, which then drops bytes rather than whole
+    // samples so can't be read.  Start it again and make do with the latest sample.  Nothing moved
+    // while it was still, so unless the face was up when last seen it wasn't up then either.
+    writeRegister(c_regUserControl, c_userFifoEnable | c_userFifoReset);
+    readRegisters(c_regAccelOut, c_sampleBytes);
+    int8_t x = readAxis();
+    readAxis();
+    int8_t z = readAxis();
+    if (!g_faceUp) {
+      detectRaise(0, c_faceAwayZ);
+    }
+    return detectRaise(x, z);
+  }
+
+  readRegisters(c_regFifoCountHigh, 2);
+  uint8_t countHigh = Wire.read();
+  uint8_t countLow = Wire.read();
+  uint16_t samples = ((countHigh << 8) | countLow) / c_sampleBytes;
+
+  bool raised = false;
+  while (samples > 0) {
+    uint8_t count = min(samples, c_samplesPerRead);
+    readRegisters(c_regFifoData, count * c_sampleBytes);
+    for (uint8_t idx = 0; idx < count; idx++) {
+      int8_t x = readAxis();
+      readAxis();
+      int8_t z = readAxis();
+      raised |= detectRaise(x, z);
+    }
+    samples -= count;
+  }
+  return raised;
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Wrist raise detection with the MPU6050.  The IMU runs its accelerometer alone in its low power
+// cycle mode, logging each sample to its FIFO, and interrupts on any motion.  Only then is the FIFO
+// read, and the samples since the last read checked for the face turning up towards the wearer.
+// The IMU costs about 20uA like this, and we wake for a few milliseconds per burst of movement.
+
+void motionInitialise();
+
+// Whether the IMU has seen movement which hasn't been checked yet.  Set by its interrupt, which
+// wakes us from power down.
+bool motionPending();
+
+// Read the samples logged since the last check, returning true if they show a wrist raise, and
+// re-arm the interrupt.
+bool motionCheckRaise();
+
+// -------------------------------------------------------------------------------------------------
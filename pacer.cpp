@@ -0,0 +1,35 @@
+#include <Arduino.h>
+
+#include <avr/sleep.h>
+
+#include "pacer.h"
+
+// -------------------------------------------------------------------------------------------------
+
+void FramePacer::start(uint32_t nowMillis, uint8_t framesPerSec) {
+  m_periodMs = 1000 / framesPerSec;
+  m_nextMs = nowMillis + m_periodMs;
+}
+
+bool FramePacer::due(uint32_t nowMillis) {
+  if (m_periodMs == 0 || static_cast<int32_t>(nowMillis - m_nextMs) < 0) {
+    return false;
+  }
+
+  m_nextMs += m_periodMs;
+  if (static_cast<int32_t>(nowMillis - m_nextMs) >= 0) {
+    m_nextMs = nowMillis + m_periodMs;
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void idleSleep() {
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_enable();
+  sleep_cpu();
+  sleep_disable();
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Keeps animation to a steady frame rate, with the CPU idling between frames rather than spinning.
+
+struct FramePacer {
+
+  void start(uint32_t nowMillis, uint8_t framesPerSec);
+
+  // Whether the next frame is due, moving the schedule on if so.  Frames which are missed are dropped
+  // rather than caught up.
+  bool due(uint32_t nowMillis);
+
+  private:
+
+  uint16_t m_periodMs = 0;
+  uint32_t m_nextMs = 0;
+};
+
+// Stop the CPU until the next interrupt.  The millis() timer ticks every millisecond, so we're never
+// out for longer than that, and the peripherals (SPI, I2C, timers) keep running.
+void idleSleep();
+
+// -------------------------------------------------------------------------------------------------
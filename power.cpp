@@ -0,0 +1,45 @@
+#include <Arduino.h>
+
+#include "power.h"
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  // From the SSD1306 and panel datasheets: a dark panel still draws about 400uA, and a fully lit one
+  // about 20mA more at full contrast, so roughly 2.4uA per lit pixel, here in 1/16ths of a uA.
+  constexpr uint16_t c_darkUa = 400;
+  constexpr uint32_t c_pixelUa16 = 39;
+
+  constexpr uint8_t c_dayContrast = 0xff;
+  constexpr uint8_t c_nightContrast = 0x40;
+  constexpr uint8_t c_minContrast = 0x08;
+
+  // Night, when the face needn't be so bright, from c_nightStart to before c_nightEnd.
+  constexpr uint8_t c_nightStart = 22;
+  constexpr uint8_t c_nightEnd = 7;
+
+  // The budget of lit pixels times contrast with a full battery, enough for about 1500 pixels at
+  // full contrast.  It shrinks to a third as the battery goes flat.
+  constexpr uint32_t c_fullBudget = 1500ul * 0xff;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint16_t displayCurrentUa(uint16_t litPixels, uint8_t contrast) {
+  return c_darkUa + (litPixels * c_pixelUa16 * contrast / 0xff) / 16;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+uint8_t adaptiveContrast(uint16_t litPixels, uint8_t batteryPc, uint8_t hour) {
+  uint8_t contrast = (hour >= c_nightStart || hour < c_nightEnd) ? c_nightContrast : c_dayContrast;
+
+  uint32_t budget = c_fullBudget * (50 + min(batteryPc, 100)) / 150;
+  if (static_cast<uint32_t>(litPixels) * contrast > budget) {
+    contrast = budget / litPixels;
+  }
+  return max(contrast, c_minContrast);
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// The display's share of the battery.  An OLED draws current for each lit pixel, in proportion to
+// the contrast, so a face costs roughly its lit pixels times the contrast.
+
+// A rough estimate of the display's current in uA.
+uint16_t displayCurrentUa(uint16_t litPixels, uint8_t contrast);
+
+// The contrast to show a face at.  Dimmer at night, and heavy faces are dimmed to keep within a
+// budget of lit pixels times contrast which shrinks as the battery runs down.
+uint8_t adaptiveContrast(uint16_t litPixels, uint8_t batteryPc, uint8_t hour);
+
+// -------------------------------------------------------------------------------------------------
@@ -5,139 +5,169 @@
 #include <avr/power.h>
 #include <avr/sleep.h>
 
-#include <uRTCLib.h>
-#include <YetAnotherPcInt.h>
-
 #include "ssd1306.h"
-#include "face-lines.h"
-#include "lines.h"
+#include "battery.h"
+#include "buttons.h"
+#include "chime.h"
+#include "clock.h"
+#include "console.h"
+#include "effects.h"
+#include "faces.h"
+#include "motion.h"
+#include "pacer.h"
+#include "power.h"
+#include "trace.h"
 
 // -------------------------------------------------------------------------------------------------
 
-constexpr int8_t c_upperLeftButtonPin = 8;
-constexpr int8_t c_upperRightButtonPin = 11;
-constexpr int8_t c_lowerRightButtonPin = 10;
-
 constexpr int8_t c_leftLedPin = 13;
 constexpr int8_t c_rightLedPin = 6;
 
-constexpr int8_t c_batteryReadEnablePin = 4;
-constexpr int8_t c_batteryPin = A11;
-
 constexpr int8_t c_chargingPin = 5;
 
-constexpr int8_t c_rtcAlarmPin = 1;
-
-constexpr int8_t c_buzzerPin = 9;
+constexpr int8_t c_rtcSquareWavePin = 1;
 
 constexpr uint32_t c_showTimeTimeoutMs = 4000;
 
-// -------------------------------------------------------------------------------------------------
-// Button state and interrupt handlers.
+constexpr uint8_t c_lowBatteryPc = 10;  // Chime a warning rather than the hour below this.
 
-//volatile bool g_upperLeftButtonPressed = false;
-//volatile bool g_upperRightButtonPressed = false;
-volatile bool g_lowerRightButtonPressed = false;
+constexpr bool c_slideInFace = true;    // Slide the face up into place as it's shown.
+constexpr bool c_wobbleFace = true;     // Bob the face gently while it's shown, if it can.
+constexpr bool c_breatheFace = false;   // Slowly fade the face out and in while it's shown.
+constexpr bool c_dimStaleFace = false;  // Show the last face dimmed on waking until it's up to date.
+constexpr bool c_animateFace = true;    // Keep jittering the face while it's shown.
+constexpr bool c_wakeOnRaise = true;    // Show the face when the watch is raised to look at.
 
-void buttonLrbIsr(bool ) {
-  g_lowerRightButtonPressed = true;
-}
+constexpr uint16_t c_faceFrameBudgetUs = 20000;
+
+constexpr uint8_t c_staleContrast = 0x10;
 
 // -------------------------------------------------------------------------------------------------
-// Clock alarm interrupt handler.
+// Clock tick interrupt handler, once a second from the RTC or hourly while powered down.  Flags the
+// start of each hour.
 
 volatile bool g_isAlarmed = false;
 
-void rtcAlarmIsr() {
-  g_isAlarmed = true;
+void rtcTickIsr() {
+  if (clockTick()) {
+    g_isAlarmed = true;
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
 // Global instances.
 
 SSD1306  g_display;
-uRTCLib g_rtc(URTCLIB_ADDRESS);   // I2C address.
+SlideTransition g_transition;
+Wobble g_wobble;
+FramePacer g_facePacer;
+
+uint8_t g_face = 0;                   // Which of WatchFaces is showing.
 
 // -------------------------------------------------------------------------------------------------
 
 void setup() {
   Wire.begin();
 
-  // Pull the button pins high.
-  pinMode(c_upperLeftButtonPin, INPUT_PULLUP);
-  pinMode(c_upperRightButtonPin, INPUT_PULLUP);
-  pinMode(c_lowerRightButtonPin, INPUT_PULLUP);
-
   // Set the LED pins for output.
   pinMode(c_leftLedPin, OUTPUT);
   pinMode(c_rightLedPin, OUTPUT);
 
-  // Set the battery read enable pin for output and the charging pin for input.
-  pinMode(c_batteryReadEnablePin, OUTPUT);
+  // Set the charging pin for input.
   pinMode(c_chargingPin, INPUT_PULLUP);
 
-  // Set the RTC alarm pin for input.
-  pinMode(c_rtcAlarmPin, INPUT_PULLUP);
+  // Set the RTC square wave pin for input.
+  pinMode(c_rtcSquareWavePin, INPUT_PULLUP);
 
   // Enable USB VBUS pad so we can read the power state from the USB status register.
   USBCON |= bit(OTGPADE);
 
-  // Install an ISR for LRB and alarm.
-  PcInt::attachInterrupt(c_lowerRightButtonPin, buttonLrbIsr, FALLING);
-  attachInterrupt(digitalPinToInterrupt(c_rtcAlarmPin), rtcAlarmIsr, FALLING);
+  // Init the RTC and our copy of the time, then install ISRs for the buttons and the clock tick.
+  clockInitialise();
+  buttonsInitialise();
+  if (c_wakeOnRaise) {
+    motionInitialise();
+  }
+  attachInterrupt(digitalPinToInterrupt(c_rtcSquareWavePin), rtcTickIsr, FALLING);
 
-  // Init the RTC.
-  g_rtc.set_model(URTCLIB_MODEL_DS3231);
+  // Take a first battery reading, after that it's hourly.
+  batteryInitialise();
 
-  // Alarm 1 is every hour on the hour.
-  g_rtc.alarmClearFlag(URTCLIB_ALARM_1);
-  g_rtc.alarmSet(URTCLIB_ALARM_TYPE_1_FIXED_MS, 0, 0, 0, 0);
+  chimeInitialise();
 
   // Init the display.
   g_display.initialise();
   g_display.clear();
 
-  // Read the current date and time from the serial port just once.
-  if (getUsbAttached()) {
-    readDateTimeFromSerial();
-  }
+  // Listen for commands over USB, see console.h.  This doesn't wait for a connection.
+  Serial.begin(9600);
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void powerDown() {
-  // Power down everything.
-  g_display.turnOff();
+  traceEnd(TraceAwake);
+
+  // Leave the display RAM showing normally for when we wake.
+  g_wobble.stop(g_display);
+  g_transition.finish(g_display);
+  if (c_breatheFace) {
+    stopBreathing(g_display);
+  }
+
+  // Turn the display off, dimming it first if need be.  It keeps its RAM and charge pump setting,
+  // so the face can be turned straight back on when we wake.
+  if (c_dimStaleFace) {
+    g_display.turnOff(c_staleContrast);
+  } else {
+    g_display.turnOff();
+  }
+
+  if (getUsbAttached()) {
+    // Powering down would stop the USB clock and drop the connection, so idle instead, answering
+    // commands until there's something else to do.
+    while (!buttonsBusy() && !motionPending() && !g_isAlarmed && getUsbAttached()) {
+      pollConsole();
+      idleSleep();
+    }
+    traceBegin(TraceAwake);
+    traceBegin(TraceWake);
+    return;
+  }
+
+  // Power down everything else.  The clock's tick would wake us every second, so only the hour
+  // does while we're down.
+  clockSleep();
   power_adc_disable();
   set_sleep_mode(SLEEP_MODE_PWR_DOWN);
   sleep_enable();
 
-  // Sleep.
-  sleep_cpu();
+  // Sleep until there's something to do.  Nothing else wakes us to look again, so interrupts are held
+  // off from the check to the sleep, sei() only letting them in after the instruction that follows.
+  for (;;) {
+    cli();
+    if (buttonsBusy() || motionPending() || g_isAlarmed) {
+      sei();
+      break;
+    }
+    sei();
+    sleep_cpu();
+  }
 
   // ... wake.
 
-  // Power up.
+  // Power up.  The micros() timer is stopped while powered down, so the trace only sees us awake.
+  traceBegin(TraceAwake);
+  traceBegin(TraceWake);
   sleep_disable();
   power_adc_enable();
-  g_display.turnOn();
+  traceBegin(TraceRtc);
+  clockWake();
+  traceEnd(TraceRtc);
 }
 
 // -------------------------------------------------------------------------------------------------
 
-float getRawBattery() {
-  digitalWrite(c_batteryReadEnablePin, HIGH);
-  delay(50);
-  float value = analogRead(c_batteryPin);
-  digitalWrite(c_batteryReadEnablePin, LOW);
-  return value;
-}
-
-int16_t getBatteryPc() {
-  int16_t rawLevel = static_cast<int16_t>(getRawBattery());
-  return max(0, min(100, rawLevel - 534));
-}
-
 bool getUsbAttached() {
   // We can test if a USB data connection is up; UDADDR is the USB address register, and the ADDEN
   // bit is whether the address is enabled.
@@ -155,66 +185,6 @@ bool getCharging() {
   return getUsbPowered() && digitalRead(c_chargingPin) == LOW;
 }
 
-// -------------------------------------------------------------------------------------------------
-// Read the date and time values from the serial port.  Useful for booting after reset.  Will prompt
-// for the correct values (year, month, day, etc.) one after the other.
-
-bool readDateTimeFromSerial() {
-  Serial.begin(9600);
-  Serial.setTimeout(60 * 1000);
-
-  // Since this is happening at boot time we need to allow for a connection to be made before we
-  // start prompting.
-  for (int countdown = 10; countdown > 0; countdown--) {
-    Serial.print("Prompting for date in... "); Serial.print(countdown); Serial.println('s');
-    g_display.clear();
-    if (countdown >= 10) {
-      drawNum(g_display, countdown / 10, 34, 20, 62, 48, true);
-      drawNum(g_display, countdown % 10, 66, 20, 94, 48, true);
-    } else {
-      drawNum(g_display, countdown, 50, 20, 78, 48, true);
-    }
-    g_display.flush();
-    delay(1000);
-  }
-
-  // Double check that the USB connection is still there.  This way we can abort setting the time by
-  // unplugging the watch just after programming it.
-  if (getUsbAttached()) {
-    g_display.clear();
-    drawLetter(g_display, 'r',  4, 50, 12, 60, false);
-    drawLetter(g_display, 'e', 14, 50, 22, 60, false);
-    drawLetter(g_display, 'a', 24, 50, 32, 60, false);
-    drawLetter(g_display, 'd', 34, 50, 42, 60, false);
-    drawLetter(g_display, 't', 54, 50, 62, 60, false);
-    drawLetter(g_display, 'i', 64, 50, 72, 60, false);
-    drawLetter(g_display, 'm', 74, 50, 82, 60, false);
-    drawLetter(g_display, 'e', 84, 50, 92, 60, false);
-    g_display.flush();
-
-    auto readValueWithPrompt = [](const char* prompt) -> uint8_t {
-      Serial.print(prompt);
-      uint8_t value = Serial.parseInt();
-      Serial.print("Got: "); Serial.println(value);
-      return value;
-    };
-
-    // If year is a zero then we probably had a timeout (it's not Y2K) and so we can just abort.
-    uint8_t year = readValueWithPrompt("Year? (00-99, 0 to skip) ");
-    if (year != 0) {
-      uint8_t month = readValueWithPrompt("Month? (1-12) ");
-      uint8_t day = readValueWithPrompt("Day? (1-31) ");
-      uint8_t dayOfWeek = readValueWithPrompt("Weekday? (Su 1, Mo 2, Tu 3, We 4, Th 5, Fr 6, Sa 7) ");
-      uint8_t hour = readValueWithPrompt("Hour? (0-23) ");
-      uint8_t minute = readValueWithPrompt("Minute? (0-59) ");
-
-      g_rtc.set(0, minute, hour, dayOfWeek, day, month, year);
-    }
-  }
-
-  Serial.end();
-}
-
 // -------------------------------------------------------------------------------------------------
 // Here's a dumb check for elapsed time, checking if a millis() value has passed but accounting for
 // overflow.
@@ -236,60 +206,151 @@ bool hasElapsed(uint32_t nowMillis, uint32_t futureMillis) {
 // -------------------------------------------------------------------------------------------------
 // Generally we just sleep to save power.
 //
-// We can wake for two reasons:
-// - A lower right button press for which we show the time.
-// - An on the hour alarm for which we beep.
+// We can wake for a few reasons:
+// - A button press, for which we show the time if it's the lower right, or show the next face if
+//   the upper right is clicked.
+// - Movement, for which we show the time if the watch was raised to look at.
+// - The clock ticking over the hour, for which we beep.
 
 bool g_showingTime = false;           // Are we currently awake and showing the time?
 bool g_refreshTime = false;           // Whether to refresh the display with the time.
 uint32_t g_stopShowingTime = 0;       // When do we next turn it off and go back to sleep?
+uint8_t g_shownMinute = 0xff;         // The minute last drawn.
+
+void showTime(uint32_t nowMillis) {
+  // Show the last face right away, it's brought up to date below if the time has moved on.  Unless
+  // it's to stay dimmed until then, it comes on at the contrast it would be drawn at now.
+  if (!g_showingTime) {
+    if (c_dimStaleFace) {
+      g_display.turnOn();
+    } else {
+      g_display.turnOn(adaptiveContrast(g_display.litPixels(), batteryPercent(), clockNow().hour));
+    }
+  }
+
+  g_showingTime = true;
+  g_refreshTime = true;
+  g_stopShowingTime = nowMillis + c_showTimeTimeoutMs;
+}
+
+// Dim heavy faces, more so as the battery runs down, and everything at night.  Whatever's drawn may
+// light more or fewer pixels, so this follows each frame.
+void updateContrast(uint8_t hour) {
+  uint16_t litPixels = g_display.litPixels();
+  g_display.setContrast(adaptiveContrast(litPixels, batteryPercent(), hour));
+  traceSet(TraceLitPixels, litPixels);
+  traceSet(TraceDisplayUa, displayCurrentUa(litPixels, g_display.contrast()));
+}
+
+void pollConsole() {
+  // If the time is set while it's showing, show the new time.
+  if (consolePoll(g_display) && g_showingTime) {
+    g_refreshTime = true;
+  }
+}
 
 void loop() {
   uint32_t nowMillis = millis();
 
-  // Check our global flags which may be set by interrupts.
-  if (g_lowerRightButtonPressed) {
-    // Acknowledge and clear.
-    g_lowerRightButtonPressed = false;
+  if (getUsbAttached()) {
+    pollConsole();
+  }
 
-    // Show the time.
-    g_showingTime = true;
-    g_refreshTime = true;
-    g_stopShowingTime = nowMillis + c_showTimeTimeoutMs;
+  // Check the buttons and our global flags which may be set by interrupts.
+  ButtonEvent event;
+  while (buttonsNextEvent(nowMillis, event)) {
+    if (event.button == ButtonLowerRight && event.gesture == GesturePress) {
+      showTime(nowMillis);
+    }
+    if (event.button == ButtonUpperRight && event.gesture == GestureClick) {
+      // Both faces need drawing afresh, the old one has been drawn over and the new one's display
+      // RAM may be long gone.
+      WatchFaces::invalidate(g_face);
+      g_face = (g_face + 1) % WatchFaces::c_count;
+      WatchFaces::invalidate(g_face);
+      showTime(nowMillis);
+    }
+  }
+  if (motionPending() && motionCheckRaise()) {
+    showTime(nowMillis);
   }
   if (g_isAlarmed) {
     // Acknowledge and clear.
-    g_rtc.alarmClearFlag(URTCLIB_ALARM_1);
     g_isAlarmed = false;
 
-    // Ignore after hours.
-    g_rtc.refresh();
-    uint8_t hour = g_rtc.hour();
+    // Keep the battery level fresh while we're up anyway.  The clock's already been read on waking.
+    traceBegin(TraceBattery);
+    batterySample();
+    traceEnd(TraceBattery);
+
+    // Do a little beep, or a warning if the battery's low, but not after hours.  It plays while we
+    // get on with anything else.
+    uint8_t hour = clockNow().hour;
     if (hour >= 9 && hour <= 23) {
-        // Do a little beep.  Args are pin, freq Hz and duration ms.
-        tone(c_buzzerPin, 2000, 50); delay(50);
-        tone(c_buzzerPin, 3000, 50); delay(50);
-        tone(c_buzzerPin, 2000, 50); delay(50);
+      chimePlay(batteryPercent() < c_lowBatteryPc ? ChimeLowBattery : ChimeHourly);
     }
   }
 
-  // Show the time if required.
+  // Show the time if required, including when the minute rolls over while it's showing.
+  if (g_showingTime && clockNow().minute != g_shownMinute) {
+    g_refreshTime = true;
+  }
   if (g_refreshTime) {
-    g_rtc.refresh();
-    printLinesFace(g_display,
-                   g_rtc.month(), g_rtc.day(), g_rtc.hour(), g_rtc.minute(), g_rtc.second(),
-                   g_rtc.dayOfWeek(),
-                   getBatteryPc());
+    ClockTime now = clockNow();
+    g_shownMinute = now.minute;
+    FaceValues values = {
+      now.month, now.day, now.hour, now.minute, now.second, now.dayOfWeek, batteryPercent(),
+      getCharging(), chimeVolume() != VolumeOff
+    };
+    if (WatchFaces::changedPages(g_face, values) != 0) {
+      if (c_slideInFace) {
+        g_wobble.stop(g_display);
+        g_transition.start(g_display, nowMillis);
+      }
+
+      traceBegin(TraceRender);
+      WatchFaces::draw(g_face, g_display, values);
+      traceEnd(TraceRender);
+    }
+
+    updateContrast(now.hour);
+    traceEnd(TraceWake);
+
+    if (c_wobbleFace && WatchFaces::wobbles(g_face)) {
+      g_wobble.start(nowMillis);
+    } else {
+      g_wobble.stop(g_display);
+    }
+    if (c_breatheFace) {
+      startBreathing(g_display);
+    }
+    if (c_animateFace && WatchFaces::framesPerSec(g_face) != 0) {
+      g_facePacer.start(nowMillis, WatchFaces::framesPerSec(g_face));
+    }
     g_refreshTime = false;
   }
+  if (!g_transition.step(g_display, nowMillis)) {
+    g_wobble.step(g_display, nowMillis);
+  }
+
+  if (c_animateFace && g_showingTime && WatchFaces::framesPerSec(g_face) != 0 &&
+      g_facePacer.due(nowMillis)) {
+    traceBegin(TraceRender);
+    WatchFaces::animate(g_face, g_display, c_faceFrameBudgetUs);
+    traceEnd(TraceRender);
+    updateContrast(clockNow().hour);
+  }
 
   if (hasElapsed(nowMillis, g_stopShowingTime)) {
     g_showingTime = false;
   }
 
-  if (!g_showingTime) {
+  if (!g_showingTime && !chimePlaying() && !buttonsBusy()) {
     // We're not busy doing anything else, go to sleep.
     powerDown();
+  } else {
+    // Nothing to do until the next frame, step or note, which the millis() tick will wake us for.
+    idleSleep();
   }
 }
 
@@ -1,4 +1,5 @@
 #include "ssd1306.h"
+#include "trace.h"
 
 #include <SPI.h>
 
@@ -12,32 +13,37 @@ namespace {
   constexpr int8_t c_chipSelectPin = A5;
   constexpr int8_t c_resetPin = A4;
 
-  constexpr int8_t c_cmdDisplayOff      = 0xae;
-  constexpr int8_t c_cmdDisplayOn       = 0xaf;
-  constexpr int8_t c_cmdDisplayResume   = 0xa4;
+  constexpr uint8_t c_cmdDisplayOff      = 0xae;
+  constexpr uint8_t c_cmdDisplayOn       = 0xaf;
+  constexpr uint8_t c_cmdDisplayResume   = 0xa4;
 
-  constexpr int8_t c_cmdNormalDisplay   = 0xa6;
-  constexpr int8_t c_cmdInverseDisplay  = 0xa7;
-  constexpr int8_t c_cmdSetContrast     = 0x81;
+  constexpr uint8_t c_cmdNormalDisplay   = 0xa6;
+  constexpr uint8_t c_cmdInverseDisplay  = 0xa7;
+  constexpr uint8_t c_cmdSetContrast     = 0x81;
 
-  constexpr int8_t c_cmdSetChargePump   = 0x8d;
-  constexpr int8_t c_chargePumpDisable  = 0x10;
-  constexpr int8_t c_chargePumpEnable   = 0x14;
+  constexpr uint8_t c_cmdSetChargePump   = 0x8d;
+  constexpr uint8_t c_chargePumpDisable  = 0x10;
+  constexpr uint8_t c_chargePumpEnable   = 0x14;
 
-  constexpr int8_t c_cmdSetDivideRatio  = 0xd5;
-  constexpr int8_t c_cmdSetPreCharge    = 0xd9;
-  constexpr int8_t c_cmdSetCompPins     = 0xda;
-  constexpr int8_t c_cmdSetVComDeselect = 0xdb;
+  constexpr uint8_t c_cmdSetDivideRatio  = 0xd5;
+  constexpr uint8_t c_cmdSetPreCharge    = 0xd9;
+  constexpr uint8_t c_cmdSetCompPins     = 0xda;
+  constexpr uint8_t c_cmdSetVComDeselect = 0xdb;
 
-  constexpr int8_t c_cmdMemoryAddrMode  = 0x20;
-  constexpr int8_t c_horizMode          = 0x00;
-  constexpr int8_t c_vertMode           = 0x01;
-  constexpr int8_t c_pageMode           = 0x02;
+  constexpr uint8_t c_cmdMemoryAddrMode  = 0x20;
+  constexpr uint8_t c_horizMode          = 0x00;
+  constexpr uint8_t c_vertMode           = 0x01;
+  constexpr uint8_t c_pageMode           = 0x02;
+  constexpr uint8_t c_cmdColumnAddr      = 0x21;
+  constexpr uint8_t c_cmdPageAddr        = 0x22;
 
-  constexpr int8_t c_cmdSegRemap        = 0xa0;
-  constexpr int8_t c_cmdComScan         = 0xc0;
-  constexpr int8_t c_scanInc            = 0x00;
-  constexpr int8_t c_scanDec            = 0x08;
+  constexpr uint8_t c_cmdSetStartLine    = 0x40;
+  constexpr uint8_t c_cmdSetFade         = 0x23;
+
+  constexpr uint8_t c_cmdSegRemap        = 0xa0;
+  constexpr uint8_t c_cmdComScan         = 0xc0;
+  constexpr uint8_t c_scanInc            = 0x00;
+  constexpr uint8_t c_scanDec            = 0x08;
 
   // -----------------------------------------------------------------------------------------------
 
@@ -45,40 +51,140 @@ namespace {
     SpiCommand, SpiData,
   };
 
-  void sendSpi(SpiCommandOrData cmdOrData, int8_t* bytes, size_t len) {
+  void beginSpi(SpiCommandOrData cmdOrData) {
     // Command == DC pin LOW, data == DC pin HIGH.
     digitalWrite(c_dataCommandPin, cmdOrData == SpiCommand ? LOW : HIGH);
 
     // 20MHz, MSB first, clock phase and polarity choice.
     SPI.beginTransaction(SPISettings(20000000, MSBFIRST, SPI_MODE0));
 
-    // Choose our slave and transfer the command(s) or data.
+    // Choose our slave.
     digitalWrite(c_chipSelectPin, LOW);
-    if (len == 1) {
-      SPI.transfer(bytes[0]);
-    } else {
-      SPI.transfer(bytes, len);
-    }
+  }
 
+  void endSpi() {
     // Deselect the slave and finish.
     digitalWrite(c_chipSelectPin, HIGH);
     SPI.endTransaction();
   }
 
-  void sendSpi(int8_t byte) {
+  void transferSpi(const uint8_t* bytes, size_t len) {
+    // The buffer variant of SPI.transfer() overwrites the buffer with whatever it reads back, which
+    // would trash our frame buffer, so send a byte at a time.
+    traceCount(TraceSpiBytes, len);
+    while (len-- > 0) {
+      SPI.transfer(*bytes++);
+    }
+  }
+
+  void sendSpi(SpiCommandOrData cmdOrData, const uint8_t* bytes, size_t len) {
+    beginSpi(cmdOrData);
+    transferSpi(bytes, len);
+    endSpi();
+  }
+
+  void sendSpi(uint8_t byte) {
     sendSpi(SpiCommand, &byte, 1);
   }
 
-  void sendSpi(int8_t byte0, int8_t byte1) {
-    int8_t bytes[2] = { byte0, byte1 };
+  void sendSpi(uint8_t byte0, uint8_t byte1) {
+    uint8_t bytes[2] = { byte0, byte1 };
     sendSpi(SpiCommand, bytes, 2);
   }
+
+  // As transferSpi() but straight from PROGMEM.
+  void transferSpiP(const uint8_t* bytes, uint8_t len) {
+    traceCount(TraceSpiBytes, len);
+    while (len-- > 0) {
+      SPI.transfer(pgm_read_byte(bytes++));
+    }
+  }
+
+  // Restrict the next data writes to columns left to right and pages top to bottom.  The address
+  // wraps within the window in horizontal addressing mode.
+  void sendWindow(uint8_t left, uint8_t right, uint8_t top, uint8_t bottom) {
+    uint8_t bytes[6] = { c_cmdColumnAddr, left, right, c_cmdPageAddr, top, bottom };
+    sendSpi(SpiCommand, bytes, 6);
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Command sequences.
+
+  constexpr uint8_t c_initCommands[] PROGMEM = {
+    c_cmdDisplayOff,                          // Disable display.
+
+    c_cmdSetChargePump, c_chargePumpEnable,   // Enable internal voltage charge pump.
+    c_cmdSetDivideRatio, 0x80,                // Defaults to 1 but 0x80 seems to be the go.
+    c_cmdSetPreCharge, 0xf1,                  // Pre-charge period, phase 1 == 1, phase 2 == 15.
+    c_cmdSetCompPins, 0x12,                   // Alternative COM pins, disable left/right remap.
+    c_cmdSetVComDeselect, 0x40,               // Vcomh regulator output. > 0.83 x Vcc?
+
+    c_cmdMemoryAddrMode, c_horizMode,         // Horizontal addressing.
+    c_cmdSegRemap | 1,                        // Reverse segments, column 127 at SEG0.
+    c_cmdComScan | c_scanDec,                 // Reverse scan direction, column 127 to 0.
+
+    c_cmdSetContrast, 0xff,                   // Full brightness.
+
+    c_cmdDisplayResume,                       // Map from the internal buffer.
+    c_cmdDisplayOn,                           // Enable display.
+  };
+
+  // State changes.  The lists ending in c_cmdSetContrast are sent with the level to follow, so
+  // powering down or waking can change the contrast in the same transaction.
+  constexpr uint8_t c_offCommands[] PROGMEM = { c_cmdDisplayOff };
+  constexpr uint8_t c_onCommands[] PROGMEM = { c_cmdDisplayOn };
+  constexpr uint8_t c_offContrastCommands[] PROGMEM = { c_cmdDisplayOff, c_cmdSetContrast };
+  constexpr uint8_t c_onContrastCommands[] PROGMEM = { c_cmdDisplayOn, c_cmdSetContrast };
+  constexpr uint8_t c_normalCommands[] PROGMEM = { c_cmdNormalDisplay };
+  constexpr uint8_t c_inverseCommands[] PROGMEM = { c_cmdInverseDisplay };
+  constexpr uint8_t c_contrastCommands[] PROGMEM = { c_cmdSetContrast };
+
+  // -----------------------------------------------------------------------------------------------
+  // Cohen-Sutherland out codes for clipping lines to the screen columns and the rows top to bottom.
+
+  enum OutCode : uint8_t {
+    OutLeft = 1, OutRight = 2, OutTop = 4, OutBottom = 8,
+  };
+
+  uint8_t outCode(int16_t x, int16_t y, int16_t top, int16_t bottom) {
+    return (x < 0 ? OutLeft : (x > 127 ? OutRight : 0)) | (y < top ? OutTop : (y > bottom ? OutBottom : 0));
+  }
+
+  // -----------------------------------------------------------------------------------------------
+  // Merging the windows for adjacent pages saves a command transaction per page, but sends every
+  // column in the union.  Roughly how many wasted data bytes a separate window is worth.
+  constexpr uint8_t c_windowOverhead = 12;
+
+  // The set bits in a byte, folding its bits together rather than using a table.
+  uint8_t countBits(uint8_t bits) {
+    bits = bits - ((bits >> 1) & 0x55);
+    bits = (bits & 0x33) + ((bits >> 2) & 0x33);
+    return (bits + (bits >> 4)) & 0x0f;
+  }
+
+  uint8_t countBits(const uint8_t* bytes, uint8_t len) {
+    uint8_t count = 0;
+    while (len-- > 0) {
+      count += countBits(*bytes++);
+    }
+    return count;
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
 // The buffered backing for our pixel data.
 
-uint8_t SSD1306::m_buffer[1024];
+uint8_t SSD1306::m_buffer[c_bufferPages * 128];
+
+#if SSD1306_BUFFER_PAGES < 8
+uint8_t SSD1306::m_bandPage = 0;
+bool SSD1306::m_retaining = false;
+#endif
+
+SSD1306::Span SSD1306::m_dirty[8];
+SSD1306::Span SSD1306::m_used[8];
+
+uint8_t SSD1306::m_blockLit[8][128 / c_litBlockCols];
 
 // -------------------------------------------------------------------------------------------------
 
@@ -97,73 +203,892 @@ void SSD1306::initialise() {
   // Initialise SPI.
   SPI.begin();
 
-  turnOff();                                       // Disable display.
+  sendCommands(c_initCommands, sizeof(c_initCommands));
+  m_contrast = 0xff;
+  m_inverted = false;
 
-  sendSpi(c_cmdSetChargePump, c_chargePumpEnable); // Enable internal voltage charge pump.
-  sendSpi(c_cmdSetDivideRatio, 0x80);              // Defaults to 1 but 0x80 seems to be the go.
-  sendSpi(c_cmdSetPreCharge, 0xf1);                // Pre-charge period, phase 1 == 1, phase 2 == 15.
-  sendSpi(c_cmdSetCompPins, 0x12);                 // Alternative COM pins, disable left/right remap.
-  sendSpi(c_cmdSetVComDeselect, 0x40);             // Vcomh regulator output. > 0.83 x Vcc?
+  // The display RAM is garbage after a reset so the whole buffer needs to go on the first flush.
+  for (uint8_t page = 0; page < 8; page++) {
+    m_dirty[page].fill();
+    m_used[page].empty();
+    memset(m_blockLit[page], 0, sizeof(m_blockLit[page]));
+  }
+}
 
-  sendSpi(c_cmdMemoryAddrMode, c_horizMode);       // Horizontal addressing.
-  sendSpi(c_cmdSegRemap | 1);                      // Reverse segments, column 127 at SEG0.
-  sendSpi(c_cmdComScan | c_scanDec);               // Reverse scan direction, column 127 to 0.
+// -------------------------------------------------------------------------------------------------
+// Send a list of command bytes from PROGMEM in a single transaction, optionally followed by a value
+// for the last of them.
 
-  setContrast(0xffu);                              // Full brightness.
+void SSD1306::sendCommands(const uint8_t* commands, uint8_t len) const {
+  beginSpi(SpiCommand);
+  transferSpiP(commands, len);
+  endSpi();
+}
 
-  sendSpi(c_cmdDisplayResume);                     // Map from the internal buffer.
-  turnOn();                                        // Enable display.
+void SSD1306::sendCommands(const uint8_t* commands, uint8_t len, uint8_t value) const {
+  beginSpi(SpiCommand);
+  transferSpiP(commands, len);
+  transferSpi(&value, 1);
+  endSpi();
 }
 
 // -------------------------------------------------------------------------------------------------
-// Turn display off (sleep mode) or back on.
+// Turn display off (sleep mode) or back on, optionally setting the contrast as well.  The display
+// RAM and the charge pump setting are kept, so turning it back on shows the last frame with a single
+// transaction.  The contrast lands a few microseconds after the display is on, well within the
+// first frame.
 
 void SSD1306::turnOff() const {
-  sendSpi(c_cmdDisplayOff);
+  sendCommands(c_offCommands, sizeof(c_offCommands));
+}
+
+void SSD1306::turnOff(uint8_t contrast) {
+  sendCommands(c_offContrastCommands, sizeof(c_offContrastCommands), contrast);
+  m_contrast = contrast;
 }
 
 void SSD1306::turnOn() const {
-  sendSpi(c_cmdDisplayOn);
+  sendCommands(c_onCommands, sizeof(c_onCommands));
+}
+
+void SSD1306::turnOn(uint8_t contrast) {
+  sendCommands(c_onContrastCommands, sizeof(c_onContrastCommands), contrast);
+  m_contrast = contrast;
 }
 
 // -------------------------------------------------------------------------------------------------
-// Invert (black on white) or restore the display mode, and set the contrast level.
+// Invert (black on white) or restore the display mode, and set the contrast level.  Setting the
+// level it's already at sends nothing.
+
+void SSD1306::nonInvert() {
+  sendCommands(c_normalCommands, sizeof(c_normalCommands));
+  m_inverted = false;
+}
+
+void SSD1306::invert() {
+  sendCommands(c_inverseCommands, sizeof(c_inverseCommands));
+  m_inverted = true;
+}
+
+void SSD1306::setContrast(uint8_t level) {
+  if (level != m_contrast) {
+    sendCommands(c_contrastCommands, sizeof(c_contrastCommands), level);
+    m_contrast = level;
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// Lit pixel counting.
+
+uint16_t SSD1306::litPixels() const {
+  uint16_t lit = 0;
+  for (uint8_t page = 0; page < 8; page++) {
+    for (uint8_t block = 0; block < 128 / c_litBlockCols; block++) {
+      lit += m_blockLit[page][block];
+    }
+  }
+  return m_inverted ? 128 * 64 - lit : lit;
+}
+
+// Recount the blocks of a page after sending columns left to right of it.  With the whole page in the
+// buffer those blocks are counted in full, otherwise the columns in them which weren't sent are
+// scaled from the old count.
+
+void SSD1306::countLit(uint8_t page, uint8_t left, uint8_t right) {
+  if (!m_retaining) {
+    left -= left % c_litBlockCols;
+    right |= c_litBlockCols - 1;
+  }
+
+  uint8_t blockLit[128 / c_litBlockCols];
+  for (uint8_t block = left / c_litBlockCols; block <= right / c_litBlockCols; block++) {
+    uint8_t first = max(left, static_cast<uint8_t>(block * c_litBlockCols));
+    uint8_t last = min(right, static_cast<uint8_t>(block * c_litBlockCols + c_litBlockCols - 1));
+    blockLit[block] = countBits(bufferAt(page, first), last - first + 1);
+  }
+  setLit(page, left, right, blockLit);
+}
 
-void SSD1306::nonInvert() const {
-  sendSpi(c_cmdNormalDisplay);
+// Update the blocks of a page from the lit pixels counted in each as columns left to right were sent.
+
+void SSD1306::setLit(uint8_t page, uint8_t left, uint8_t right, const uint8_t* blockLit) {
+  for (uint8_t block = left / c_litBlockCols; block <= right / c_litBlockCols; block++) {
+    uint8_t blockLeft = block * c_litBlockCols;
+    uint8_t sentLeft = max(left, blockLeft);
+    uint8_t sentRight = min(right, static_cast<uint8_t>(blockLeft + c_litBlockCols - 1));
+    uint8_t sentCols = sentRight - sentLeft + 1;
+    m_blockLit[page][block] =
+      blockLit[block] + m_blockLit[page][block] * (c_litBlockCols - sentCols) / c_litBlockCols;
+  }
 }
 
-void SSD1306::invert() const {
-  sendSpi(c_cmdInverseDisplay);
+// -------------------------------------------------------------------------------------------------
+// Shift the whole display up by line rows, wrapping around, without touching the display RAM.
+
+void SSD1306::setStartLine(uint8_t line) const {
+  sendSpi(c_cmdSetStartLine | (line & 0x3f));
 }
 
-void SSD1306::setContrast(uint8_t level) const {
-  sendSpi(c_cmdSetContrast, level);
+// -------------------------------------------------------------------------------------------------
+// Fade the display out, or blink it by fading out and in continuously, stepping the contrast every
+// 8 x (framesPerStep8 + 1) frames.  FadeNone restores it.
+
+void SSD1306::setFade(FadeMode mode, uint8_t framesPerStep8) const {
+  sendSpi(c_cmdSetFade, mode | (framesPerStep8 & 0x0f));
 }
 
 // -------------------------------------------------------------------------------------------------
 
 void SSD1306::clear(int8_t val /*= 0*/) {
-  memset(m_buffer, val, 1024);
+  memset(m_buffer, val, c_bufferPages * 128);
+
+  for (uint8_t page = m_bandPage; page < m_bandPage + c_bufferPages; page++) {
+    if (val == 0) {
+      // Only the columns we drew into have actually changed.
+      m_dirty[page].extend(m_used[page]);
+      m_used[page].empty();
+    } else {
+      m_dirty[page].fill();
+      m_used[page].fill();
+    }
+  }
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// Send only the dirty parts of the buffer.  Each run of dirty pages becomes a window (or a few) on
+// the display and the rest of its RAM is left alone.
+
+void SSD1306::flush() {
+  TraceScope trace(TraceFlush);
+
+  const uint8_t lastPage = m_bandPage + c_bufferPages - 1;
+
+  uint8_t page = m_bandPage;
+  while (page <= lastPage) {
+    if (m_dirty[page].isEmpty()) {
+      page++;
+      continue;
+    }
+
+    // Grow the window down while it doesn't cost more than another window would.  A retained band
+    // only holds what's dirty, so can't send any extra columns.
+    Span window = m_dirty[page];
+    int16_t usedBytes = window.right - window.left + 1;
+    uint8_t bottom = page;
+    while (!m_retaining && bottom < lastPage && !m_dirty[bottom + 1].isEmpty()) {
+      Span merged = window;
+      merged.extend(m_dirty[bottom + 1]);
+      int16_t mergedBytes = (merged.right - merged.left + 1) * (bottom + 2 - page);
+      int16_t nextBytes = m_dirty[bottom + 1].right - m_dirty[bottom + 1].left + 1;
+      if (mergedBytes > usedBytes + nextBytes + c_windowOverhead) {
+        break;
+      }
+      window = merged;
+      usedBytes += nextBytes;
+      bottom++;
+    }
+
+    sendWindow(window.left, window.right, page, bottom);
+
+    beginSpi(SpiData);
+    for (; page <= bottom; page++) {
+      transferSpi(bufferAt(page, window.left), window.right - window.left + 1);
+      countLit(page, window.left, window.right);
+      m_dirty[page].empty();
+    }
+    endSpi();
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// The picture loop.  With the whole screen buffered it's just a clear and a flush, otherwise each
+// band is cleared, drawn and flushed in turn.
+
+void SSD1306::firstPage(bool retain /*= false*/) {
+#if SSD1306_BUFFER_PAGES < 8
+  m_bandPage = 0;
+
+  m_retaining = retain;
+  if (m_retaining) {
+    memset(m_buffer, 0, c_bufferPages * 128);
+  } else {
+    clear();
+  }
+#else
+  // The full buffer still matches the display.
+  if (!retain) {
+    clear();
+  }
+#endif
+}
+
+bool SSD1306::nextPage() {
+  flush();
+
+#if SSD1306_BUFFER_PAGES < 8
+  if (m_bandPage + c_bufferPages < 8) {
+    m_bandPage += c_bufferPages;
+    if (m_retaining) {
+      memset(m_buffer, 0, c_bufferPages * 128);
+    } else {
+      clear();
+    }
+    return true;
+  }
+  m_retaining = false;
+#endif
+  return false;
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// Clear the pixels in a rectangle and send it on the next flush.  Columns which had pixels there may
+// still have some elsewhere in the page, so are left marked as used.
+
+void SSD1306::clearRect(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+  if (left < 0) { left = 0; }
+  if (right > 127) { right = 127; }
+  if (top < clipTop()) { top = clipTop(); }
+  if (bottom > clipBottom()) { bottom = clipBottom(); }
+  if (left > right || top > bottom) {
+    return;
+  }
+
+  uint8_t lastPage = bottom / 8;
+  for (uint8_t page = top / 8; page <= lastPage; page++) {
+    uint8_t mask = 0xff;
+    if (page == top / 8) { mask &= 0xff << (top % 8); }
+    if (page == lastPage) { mask &= 0xff >> (7 - (bottom % 8)); }
+
+    uint8_t* ptr = bufferAt(page, left);
+    for (uint8_t count = right - left + 1; count > 0; count--) {
+      *ptr++ &= ~mask;
+    }
+    m_dirty[page].extend(left, right);
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+// PROGMEM bitmaps.  Streamed bytes are counted for the lit pixels like a flush, and marked as used so
+// that a clear() sends the buffer back over them.
+
+void SSD1306::streamBitmap(const uint8_t* bitmap, uint8_t left, uint8_t topPage, uint8_t width,
+                           uint8_t pages, BitmapCodec codec /*= BitmapRaw*/) {
+  TraceScope trace(TraceFlush);
+
+  // The window being sent, where the next byte lands in it and the lit pixels sent to each block of
+  // the current page.
+  uint8_t windowLeft = left, windowRight = left + width - 1;
+  uint8_t page = topPage, col = left;
+  uint8_t blockLit[128 / c_litBlockCols] = {};
+  uint16_t sent = 0;
+
+  auto send = [&](uint8_t byte) {
+    SPI.transfer(byte);
+    sent++;
+    blockLit[col / c_litBlockCols] += countBits(byte);
+    if (col++ == windowRight) {
+      setLit(page, windowLeft, windowRight, blockLit);
+      m_used[page].extend(windowLeft, windowRight);
+      memset(blockLit, 0, sizeof(blockLit));
+      col = windowLeft;
+      page++;
+    }
+  };
+
+  if (codec == BitmapDelta) {
+    // A window per run.
+    for (;;) {
+      uint8_t runPage = pgm_read_byte(bitmap++);
+      if (runPage == 0xff) {
+        break;
+      }
+      windowLeft = left + pgm_read_byte(bitmap++);
+      windowRight = windowLeft + pgm_read_byte(bitmap++);
+      page = topPage + runPage;
+      col = windowLeft;
+      sendWindow(windowLeft, windowRight, page, page);
+
+      beginSpi(SpiData);
+      for (uint8_t count = windowRight - windowLeft + 1; count > 0; count--) {
+        send(pgm_read_byte(bitmap++));
+      }
+      endSpi();
+    }
+  } else {
+    sendWindow(windowLeft, windowRight, topPage, topPage + pages - 1);
+
+    beginSpi(SpiData);
+    uint16_t remaining = width * pages;
+    if (codec == BitmapRaw) {
+      while (remaining-- > 0) {
+        send(pgm_read_byte(bitmap++));
+      }
+    } else {
+      while (remaining > 0) {
+        uint8_t run = pgm_read_byte(bitmap++);
+        uint8_t count = (run & 0x7f) + 1;
+        if (count > remaining) {
+          count = remaining;
+        }
+        remaining -= count;
+        if (run < 0x80) {
+          while (count-- > 0) {
+            send(pgm_read_byte(bitmap++));
+          }
+        } else {
+          uint8_t byte = pgm_read_byte(bitmap++);
+          while (count-- > 0) {
+            send(byte);
+          }
+        }
+      }
+    }
+    endSpi();
+  }
+
+  traceCount(TraceSpiBytes, sent);
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// Sprites sit on whole pages, so each byte is ORed straight in without shifting.
+
+void SSD1306::drawSprite(const uint8_t* sprite, int16_t left, uint8_t topPage, uint8_t width,
+                         uint8_t pages) {
+  int16_t first = max(left, 0);
+  int16_t last = min(left + width - 1, 127);
+  if (first > last) {
+    return;
+  }
+
+  for (uint8_t row = 0; row < pages; row++) {
+    uint8_t page = topPage + row;
+    if (page < m_bandPage || page >= m_bandPage + c_bufferPages) {
+      continue;
+    }
+
+    const uint8_t* bytes = sprite + row * width + (first - left);
+    uint8_t* ptr = bufferAt(page, first);
+    for (int16_t x = first; x <= last; x++) {
+      *ptr++ |= pgm_read_byte(bytes++);
+    }
+    m_dirty[page].extend(first, last);
+    m_used[page].extend(first, last);
+  }
 }
 
-void SSD1306::flush() const {
-  sendSpi(SpiData, m_buffer, 1024);
+// -------------------------------------------------------------------------------------------------
+// Mark a rectangle as dirty and used.
+
+void SSD1306::markDirty(uint8_t left, uint8_t top, uint8_t right, uint8_t bottom) {
+  // In bands this must be within the buffer, not just the screen.
+  for (uint8_t page = top / 8; page <= bottom / 8; page++) {
+    m_dirty[page].extend(left, right);
+    m_used[page].extend(left, right);
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
 // Set a pixel in the backing buffer.  Must be 0 < x < 128 and 0 < y < 64.
 
 void SSD1306::setPixel(int8_t x, int8_t y) {
-  if (x < 0 || x > 127 || y < 0 || y > 63) {
+  traceCount(TracePixels);
+
+  if (x < 0 || y < clipTop() || y > clipBottom()) {
     return;
   }
 
   // The pixels are stacked column wise in the display RAM which we mimic here.  The first byte in
   // the buffer represents the 8 pixels at x offset 0, and y offset 0 to 7, LSB first.  The second
   // 8-bit byte represents the 8 pixels at x offset 1, and y offset 0 to 7.
-  int16_t offs = ((y / 8) * 128) + x;
-  m_buffer[offs] |= (1 << (y % 8));
+  uint8_t page = y / 8;
+  *bufferAt(page, x) |= (1 << (y % 8));
+
+  m_dirty[page].extend(x);
+  m_used[page].extend(x);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Lines.  Horizontal and vertical runs are ORed into the buffer a byte at a time.  Anything else is
+// walked with Bresenham, stepping a pointer and bit mask through the buffer rather than recalculating
+// the address for each pixel.
+//
+// Diagonals are clipped using the Cohen-Sutherland out codes of their ends.  Moving an end to the
+// edge of the clip area would shift the raster from there on, and leave a kink where a line crosses
+// from one band to the next, so instead any part before the clip area is stepped over without
+// plotting and the walk stops where the line leaves.  Only lines which cross the clip edge pay for
+// the extra checks.
+
+void SSD1306::drawLine(int16_t ax, int16_t ay, int16_t bx, int16_t by, uint8_t width /*= 1*/) {
+  traceCount(TraceLines);
+  if (width > 1) {
+    drawThickLine(ax, ay, bx, by, width);
+    return;
+  }
+  if (ay == by) {
+    drawHLine(ax, bx, ay);
+    return;
+  }
+  if (ax == bx) {
+    drawVLine(ax, ay, by);
+    return;
+  }
+
+  const int16_t top = clipTop();
+  const int16_t bottom = clipBottom();
+  uint8_t codeA = outCode(ax, ay, top, bottom);
+  uint8_t codeB = outCode(bx, by, top, bottom);
+  if ((codeA & codeB) != 0) {
+    return;
+  }
+
+  int16_t dx = abs(bx - ax);
+  int8_t sx = ax < bx ? 1 : -1;
+  int16_t dy = abs(by - ay);
+  bool down = ay < by;
+  int16_t err = (dx > dy ? dx : -dy) / 2;
+
+  // Each step moves across, down or both, so there are exactly as many as the longer axis.
+  int16_t steps = dx > dy ? dx : dy;
+
+  while (codeA != 0) {
+    if (steps-- == 0) {
+      return;
+    }
+    int16_t err2 = err;
+    if (err2 > -dx) { err -= dy; ax += sx; }
+    if (err2 <  dy) { err += dx; ay += down ? 1 : -1; }
+    codeA = outCode(ax, ay, top, bottom);
+  }
+
+  // The visible part is within the box from the start to the clamped end.
+  int16_t endX = bx < 0 ? 0 : (bx > 127 ? 127 : bx);
+  int16_t endY = by < top ? top : (by > bottom ? bottom : by);
+  markDirty(ax < endX ? ax : endX, ay < endY ? ay : endY, ax < endX ? endX : ax, ay < endY ? endY : ay);
+
+  bool checkX = (codeB & (OutLeft | OutRight)) != 0;
+  bool checkY = (codeB & (OutTop | OutBottom)) != 0;
+  uint8_t firstPage = top / 8;
+  uint8_t lastPage = bottom / 8;
+  uint8_t page = ay / 8;
+
+  uint8_t* ptr = bufferAt(page, ax);
+  uint8_t mask = 1 << (ay % 8);
+  for (;;) {
+    *ptr |= mask;
+    traceCount(TracePixels);
+    if (steps-- == 0) {
+      break;
+    }
+
+    int16_t err2 = err;
+    if (err2 > -dx) {
+      err -= dy;
+      ptr += sx;
+      if (checkX) {
+        ax += sx;
+        if (ax < 0 || ax > 127) { break; }
+      }
+    }
+    if (err2 < dy) {
+      err += dx;
+      if (down) {
+        mask <<= 1;
+        if (mask == 0) {
+          mask = 0x01; ptr += 128; page++;
+          if (checkY && page > lastPage) { break; }
+        }
+      } else {
+        mask >>= 1;
+        if (mask == 0) {
+          mask = 0x80; ptr -= 128; page--;
+          if (checkY && (page < firstPage || page > 7)) { break; }
+        }
+      }
+    }
+  }
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+void SSD1306::drawHLine(int16_t left, int16_t right, int16_t y) {
+  if (left > right) {
+    int16_t tmp = left; left = right; right = tmp;
+  }
+  if (y < clipTop() || y > clipBottom() || right < 0 || left > 127) {
+    return;
+  }
+  if (left < 0) { left = 0; }
+  if (right > 127) { right = 127; }
+
+  uint8_t page = y / 8;
+  uint8_t mask = 1 << (y % 8);
+  uint8_t* ptr = bufferAt(page, left);
+  for (uint8_t count = right - left + 1; count > 0; count--) {
+    *ptr++ |= mask;
+  }
+
+  m_dirty[page].extend(left, right);
+  m_used[page].extend(left, right);
+  traceCount(TracePixels, right - left + 1);
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+void SSD1306::drawVLine(int16_t x, int16_t top, int16_t bottom) {
+  if (top > bottom) {
+    int16_t tmp = top; top = bottom; bottom = tmp;
+  }
+  if (x < 0 || x > 127 || bottom < clipTop() || top > clipBottom()) {
+    return;
+  }
+  if (top < clipTop()) { top = clipTop(); }
+  if (bottom > clipBottom()) { bottom = clipBottom(); }
+
+  // Whole bytes for the pages in the middle, partial masks for the first and last.
+  uint8_t page = top / 8;
+  uint8_t lastPage = bottom / 8;
+  uint8_t* ptr = bufferAt(page, x);
+  uint8_t mask = 0xff << (top % 8);
+  for (; page < lastPage; page++) {
+    *ptr |= mask;
+    ptr += 128;
+    m_dirty[page].extend(x);
+    m_used[page].extend(x);
+    mask = 0xff;
+  }
+  *ptr |= mask & (0xff >> (7 - (bottom % 8)));
+  m_dirty[lastPage].extend(x);
+  m_used[lastPage].extend(x);
+  traceCount(TracePixels, bottom - top + 1);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Thick lines are walked with Bresenham as usual, but each step plots a short run across the line
+// rather than a pixel: a column mask for mostly horizontal lines, which may straddle two pages, and a
+// row of bytes for mostly vertical ones.  Straight lines are just rectangles.  Clipping is per step,
+// which keeps bands exact without the thin line's out code walk.
+
+void SSD1306::drawThickLine(int16_t ax, int16_t ay, int16_t bx, int16_t by, uint8_t width) {
+  if (width > 8) {
+    width = 8;
+  }
+  const int16_t before = (width - 1) / 2;
+  const int16_t after = width - 1 - before;
+
+  if (ay == by) {
+    fillRect(ax, ay - before, bx, ay + after);
+    return;
+  }
+  if (ax == bx) {
+    fillRect(ax - before, ay, ax + after, by);
+    return;
+  }
+
+  const int16_t top = clipTop();
+  const int16_t bottom = clipBottom();
+  int16_t boxLeft = (ax < bx ? ax : bx) - before;
+  int16_t boxRight = (ax < bx ? bx : ax) + after;
+  int16_t boxTop = (ay < by ? ay : by) - before;
+  int16_t boxBottom = (ay < by ? by : ay) + after;
+  if (boxRight < 0 || boxLeft > 127 || boxBottom < top || boxTop > bottom) {
+    return;
+  }
+  markDirty(boxLeft < 0 ? 0 : boxLeft, boxTop < top ? top : boxTop,
+            boxRight > 127 ? 127 : boxRight, boxBottom > bottom ? bottom : boxBottom);
+
+  int16_t dx = abs(bx - ax);
+  int8_t sx = ax < bx ? 1 : -1;
+  int16_t dy = abs(by - ay);
+  int8_t sy = ay < by ? 1 : -1;
+  int16_t err = (dx > dy ? dx : -dy) / 2;
+  int16_t steps = dx > dy ? dx : dy;
+  bool acrossRows = dx >= dy;
+
+  uint16_t plotted = 0;
+  for (;;) {
+    if (acrossRows) {
+      int16_t first = ay - before;
+      int16_t last = ay + after;
+      if (first < top) { first = top; }
+      if (last > bottom) { last = bottom; }
+      if (ax >= 0 && ax <= 127 && first <= last) {
+        plotted += last - first + 1;
+        uint16_t bits = ((1u << (last - first + 1)) - 1) << (first % 8);
+        uint8_t* ptr = bufferAt(first / 8, ax);
+        ptr[0] |= bits;
+        // A single page buffer clips to one page, so never spills.
+        if (c_bufferPages > 1 && bits > 0xff) {
+          ptr[128] |= bits >> 8;
+        }
+      }
+    } else {
+      int16_t first = ax - before;
+      int16_t last = ax + after;
+      if (first < 0) { first = 0; }
+      if (last > 127) { last = 127; }
+      if (ay >= top && ay <= bottom && first <= last) {
+        plotted += last - first + 1;
+        uint8_t mask = 1 << (ay % 8);
+        uint8_t* ptr = bufferAt(ay / 8, first);
+        for (int16_t x = first; x <= last; x++) {
+          *ptr++ |= mask;
+        }
+      }
+    }
+
+    if (steps-- == 0) {
+      break;
+    }
+    int16_t err2 = err;
+    if (err2 > -dx) { err -= dy; ax += sx; }
+    if (err2 <  dy) { err += dx; ay += sy; }
+  }
+  traceCount(TracePixels, plotted);
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+void SSD1306::fillRect(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+  if (left > right) {
+    int16_t tmp = left; left = right; right = tmp;
+  }
+  if (top > bottom) {
+    int16_t tmp = top; top = bottom; bottom = tmp;
+  }
+  if (left < 0) { left = 0; }
+  if (right > 127) { right = 127; }
+  if (top < clipTop()) { top = clipTop(); }
+  if (bottom > clipBottom()) { bottom = clipBottom(); }
+  if (left > right || top > bottom) {
+    return;
+  }
+
+  uint8_t lastPage = bottom / 8;
+  for (uint8_t page = top / 8; page <= lastPage; page++) {
+    uint8_t mask = 0xff;
+    if (page == top / 8) { mask &= 0xff << (top % 8); }
+    if (page == lastPage) { mask &= 0xff >> (7 - (bottom % 8)); }
+
+    uint8_t* ptr = bufferAt(page, left);
+    for (uint8_t count = right - left + 1; count > 0; count--) {
+      *ptr++ |= mask;
+    }
+    m_dirty[page].extend(left, right);
+    m_used[page].extend(left, right);
+  }
+  traceCount(TracePixels, (right - left + 1) * (bottom - top + 1));
+}
+
+// -------------------------------------------------------------------------------------------------
+// Curves, using the midpoint circle algorithm over one octant and mirroring it to the other seven.
+//
+// A rounded rectangle is a circle pulled apart at its centre, so both are drawn by the same code with
+// the corner centres inset from the edges by the radius.  Walking the octant from the top, x steps on
+// every pixel and y only some of the time, so each row of the top and bottom octants is a horizontal
+// run, and each column of the side octants a vertical run, which are drawn a byte at a time.  The
+// runs through the middle of each side join across the straight edge between the corners.
+
+void SSD1306::drawCircle(int16_t cx, int16_t cy, int16_t radius) {
+  roundRect(cx - radius, cy - radius, cx + radius, cy + radius, radius, false);
+}
+
+void SSD1306::fillCircle(int16_t cx, int16_t cy, int16_t radius) {
+  roundRect(cx - radius, cy - radius, cx + radius, cy + radius, radius, true);
+}
+
+void SSD1306::drawRoundRect(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius) {
+  roundRect(left, top, right, bottom, radius, false);
+}
+
+void SSD1306::fillRoundRect(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius) {
+  roundRect(left, top, right, bottom, radius, true);
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+
+void SSD1306::roundRect(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius,
+                        bool fill) {
+  if (left > right) {
+    int16_t tmp = left; left = right; right = tmp;
+  }
+  if (top > bottom) {
+    int16_t tmp = top; top = bottom; bottom = tmp;
+  }
+  if (radius < 0) {
+    radius = 0;
+  }
+  if (radius * 2 > right - left) { radius = (right - left) / 2; }
+  if (radius * 2 > bottom - top) { radius = (bottom - top) / 2; }
+  if (right < 0 || left > 127 || bottom < clipTop() || top > clipBottom()) {
+    return;
+  }
+
+  // The corner centres.
+  const int16_t cl = left + radius, cr = right - radius;
+  const int16_t ct = top + radius, cb = bottom - radius;
+
+  if (fill) {
+    for (int16_t y = ct + 1; y < cb; y++) {
+      drawHLine(left, right, y);
+    }
+  }
+
+  int16_t x = 0, y = radius;
+  int16_t err = 1 - radius;
+  int16_t runStart = 0;
+  while (x <= y) {
+    // Find where this row's run ends, on the last x before y steps or the octant does.
+    int16_t nextErr = err < 0 ? err + 2 * x + 3 : err + 2 * (x - y) + 5;
+    bool stepY = err >= 0;
+    if (stepY || x + 1 > y) {
+      // Rows y above and below the centres, columns y either side of them.
+      if (fill) {
+        drawHLine(cl - x, cr + x, ct - y);
+        drawHLine(cl - x, cr + x, cb + y);
+        for (int16_t row = runStart; row <= x; row++) {
+          drawHLine(cl - y, cr + y, ct - row);
+          drawHLine(cl - y, cr + y, cb + row);
+        }
+      } else if (runStart == 0) {
+        drawHLine(cl - x, cr + x, ct - y);
+        drawHLine(cl - x, cr + x, cb + y);
+        drawVLine(cl - y, ct - x, cb + x);
+        drawVLine(cr + y, ct - x, cb + x);
+      } else {
+        drawHLine(cl - x, cl - runStart, ct - y);
+        drawHLine(cr + runStart, cr + x, ct - y);
+        drawHLine(cl - x, cl - runStart, cb + y);
+        drawHLine(cr + runStart, cr + x, cb + y);
+        drawVLine(cl - y, ct - x, ct - runStart);
+        drawVLine(cr + y, ct - x, ct - runStart);
+        drawVLine(cl - y, cb + runStart, cb + x);
+        drawVLine(cr + y, cb + runStart, cb + x);
+      }
+      runStart = x + 1;
+    }
+    if (stepY) {
+      y--;
+    }
+    err = nextErr;
+    x++;
+  }
+}
+
+// -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -  -
+// An arc walks the circle's octants as above, in runs along a row of the top and bottom octants or a
+// column of the sides, and draws the parts of each run within the angles a byte at a time.
+//
+// Within an octant the angle is approximated from x / y as atan(t) ~= t * pi/4 + 0.273 * t * (1 - t),
+// to about a 256th of a turn, which takes two long divisions.  Each octant is an eighth of a turn, so
+// only those with an end of the arc in need it at all.  Even there the angle only ever moves one way
+// along a run, so a longer run is wholly within the angles if its ends are and it doesn't pass the
+// start between them, and only the runs crossing an end of the arc are checked pixel by pixel.
+
+void SSD1306::drawArc(int16_t cx, int16_t cy, int16_t radius, uint8_t startAngle, uint8_t endAngle) {
+  if (radius <= 0 || cx + radius < 0 || cx - radius > 127 || cy + radius < clipTop() || cy - radius > clipBottom()) {
+    return;
+  }
+
+  // Octants are numbered clockwise from 12 o'clock, so 1, 2, 5 and 6 are the sides and the angle
+  // falls as x grows in the odd ones.  Octant k runs from 32 * k to 32 * (k + 1).
+  const uint8_t sweep = endAngle - startAngle;
+  auto octantAngle = [](int16_t x, int16_t y) -> uint8_t {
+    return (32 * x + static_cast<int32_t>(11) * x * (y - x) / y) / y;
+  };
+  auto fromStart = [&](uint8_t octant, uint8_t a) -> uint8_t {
+    uint8_t base = ((octant + 1) / 2) * 64;
+    return ((octant & 1) != 0 ? base - a : base + a) - startAngle;
+  };
+
+  uint8_t within = 0, partly = 0;
+  for (uint8_t octant = 0; octant < 8; octant++) {
+    uint8_t first = octant * 32 - startAngle;
+    uint8_t last = first + 32;
+    if (first < last && first <= sweep && last <= sweep) {
+      within |= 1 << octant;
+    } else if (!(first < last && first > sweep && last > sweep)) {
+      partly |= 1 << octant;
+    }
+  }
+
+  // Draw x from first to last, on the row or column y out from the centre.
+  auto drawRun = [&](uint8_t octant, int16_t y, int16_t first, int16_t last) {
+    int16_t right = octant < 4 ? 1 : -1;
+    int16_t down = (octant < 2 || octant > 5) ? -1 : 1;
+    if (((octant + 1) & 2) == 0) {
+      drawHLine(cx + right * first, cx + right * last, cy + down * y);
+    } else {
+      drawVLine(cx + right * y, cy + down * first, cy + down * last);
+    }
+  };
+
+  int16_t x = 0, y = radius;
+  int16_t err = 1 - radius;
+  int16_t runStart = 0;
+  while (x <= y) {
+    bool stepY = err >= 0;
+    if (stepY || x + 1 > y) {
+      // The run is runStart to x.
+      for (uint8_t octant = 0; octant < 8; octant++) {
+        if ((within & (1 << octant)) != 0) {
+          drawRun(octant, y, runStart, x);
+        }
+      }
+
+      // The octants with an end of the arc in, less those this run is wholly within or without.  A
+      // run of one or two pixels isn't worth checking the ends of.
+      uint8_t crossing = partly;
+      if (partly != 0 && x - runStart >= 2) {
+        uint8_t runFirstAngle = octantAngle(runStart, y), runLastAngle = octantAngle(x, y);
+        for (uint8_t octant = 0; octant < 8; octant++) {
+          if ((partly & (1 << octant)) == 0) {
+            continue;
+          }
+          uint8_t firstAngle = fromStart(octant, runFirstAngle);
+          uint8_t lastAngle = fromStart(octant, runLastAngle);
+          bool passesStart = (octant & 1) != 0 ? firstAngle < lastAngle : firstAngle > lastAngle;
+          if (!passesStart && (firstAngle <= sweep) == (lastAngle <= sweep)) {
+            if (firstAngle <= sweep) {
+              drawRun(octant, y, runStart, x);
+            }
+            crossing &= ~(1 << octant);
+          }
+        }
+      }
+
+      // Those are drawn from where they come into the angles to where they leave, or the run ends.
+      if (crossing != 0) {
+        int16_t first[8];
+        for (uint8_t octant = 0; octant < 8; octant++) {
+          first[octant] = -1;
+        }
+        for (int16_t runX = runStart; runX <= x + 1; runX++) {
+          uint8_t a = runX <= x ? octantAngle(runX, y) : 0;
+          for (uint8_t octant = 0; octant < 8; octant++) {
+            if ((crossing & (1 << octant)) == 0) {
+              continue;
+            }
+            bool inArc = runX <= x && fromStart(octant, a) <= sweep;
+            if (inArc && first[octant] < 0) {
+              first[octant] = runX;
+            } else if (!inArc && first[octant] >= 0) {
+              drawRun(octant, y, first[octant], runX - 1);
+              first[octant] = -1;
+            }
+          }
+        }
+      }
+      runStart = x + 1;
+    }
+
+    if (stepY) {
+      err += 2 * (x - y) + 5;
+      y--;
+    } else {
+      err += 2 * x + 3;
+    }
+    x++;
+  }
 }
 
 // -------------------------------------------------------------------------------------------------
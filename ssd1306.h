@@ -2,24 +2,173 @@
 
 #include <stdint.h>
 
+// The frame buffer holds this many of the display's 8 pages.  Setting it to 1, 2 or 4 saves RAM by
+// drawing the screen in bands, at the cost of running the drawing code once per band.
+#ifndef SSD1306_BUFFER_PAGES
+#define SSD1306_BUFFER_PAGES 8
+#endif
+
 struct SSD1306 {
 
   void initialise();
 
+  // Send a PROGMEM list of command bytes in a single transaction, optionally followed by a value
+  // for the last of them.
+  void sendCommands(const uint8_t* commands, uint8_t len) const;
+  void sendCommands(const uint8_t* commands, uint8_t len, uint8_t value) const;
+
+  // Turning off or on can set the contrast in the same transaction.
   void turnOff() const;
+  void turnOff(uint8_t contrast);
   void turnOn() const;
+  void turnOn(uint8_t contrast);
+
+  void nonInvert();
+  void invert();
+  void setContrast(uint8_t level);
+  uint8_t contrast() const { return m_contrast; }
+
+  // How many pixels are lit on the display, counted as each page is sent.  When retaining in bands,
+  // or streaming a delta bitmap, only the columns sent are known, so the columns either side are
+  // assumed to be as lit as the block of columns around them was, which makes it an estimate.
+  uint16_t litPixels() const;
 
-  void nonInvert() const;
-  void invert() const;
-  void setContrast(uint8_t level) const;
+  // Hardware effects, run by the display itself with no further CPU or SPI traffic.  The start line
+  // shifts what's shown without touching the display RAM, and the fade steps the contrast down, or
+  // down and up again for a blink, every 8 x (framesPerStep8 + 1) frames.
+  enum FadeMode : uint8_t {
+    FadeNone = 0x00, FadeOut = 0x20, Blink = 0x30,
+  };
+
+  void setStartLine(uint8_t line) const;
+  void setFade(FadeMode mode, uint8_t framesPerStep8) const;
 
   void clear(int8_t val = 0);
-  void flush() const;
+  void flush();
+
+  // PROGMEM bitmaps, laid out as the display RAM is: a byte per column holding 8 rows, LSB at the
+  // top, along each page in turn.  Streaming sends a bitmap from flash straight to the display, so
+  // even a full screen costs no RAM, but it goes around the buffer.  Anything drawn over it later
+  // replaces it, as does the next clear(), and a face showing before it needs invalidating.
+  //
+  //   BitmapRaw    width x pages bytes.
+  //   BitmapRle    Runs, each a count byte followed by count + 1 bytes to send as they are when it's
+  //                below 0x80, otherwise by a byte to send count - 0x7f times.
+  //   BitmapDelta  The changes from the previous frame of an animation, as runs of a page, a column
+  //                and a count - 1, relative to the bitmap, each followed by count bytes.  Ends with
+  //                0xff.  Only the changes are sent.
+  //
+  // The bitmap must fit on the screen.
+  enum BitmapCodec : uint8_t {
+    BitmapRaw, BitmapRle, BitmapDelta,
+  };
+
+  void streamBitmap(const uint8_t* bitmap, uint8_t left, uint8_t topPage, uint8_t width,
+                    uint8_t pages, BitmapCodec codec = BitmapRaw);
+
+  // OR a small raw PROGMEM bitmap into the buffer, at a column and a page, e.g. an icon.
+  void drawSprite(const uint8_t* sprite, int16_t left, uint8_t topPage, uint8_t width, uint8_t pages);
+
+  // A picture loop which works whether or not the buffer holds the whole screen.  The drawing must
+  // be identical for each pass, so rewind any jitter at the top of the loop.
+  //
+  //   display.firstPage();
+  //   do {
+  //     jitterRewind();
+  //     ...draw...
+  //   } while (display.nextPage());
+  //
+  // Retaining leaves whatever is on the display alone and sends only what's cleared with clearRect()
+  // or drawn.  When drawing in bands the buffer doesn't hold the rest of the screen, so anything
+  // drawn must stay within rectangles cleared this pass, rounded out to whole pages.
+  void firstPage(bool retain = false);
+  bool nextPage();
+
+  void clearRect(int16_t left, int16_t top, int16_t right, int16_t bottom);
 
   void setPixel(int8_t x, int8_t y);
 
+  // Lines wider than a pixel grow below and to the right of the thin line, or either side of it when
+  // the width is odd.  Up to 8 pixels wide.
+  void drawLine(int16_t ax, int16_t ay, int16_t bx, int16_t by, uint8_t width = 1);
+  void drawHLine(int16_t left, int16_t right, int16_t y);
+  void drawVLine(int16_t x, int16_t top, int16_t bottom);
+  void fillRect(int16_t left, int16_t top, int16_t right, int16_t bottom);
+
+  // Curves.  Angles are in 256ths of a turn, clockwise from 12 o'clock, and arcs run clockwise from
+  // start to end inclusive.
+  void drawCircle(int16_t cx, int16_t cy, int16_t radius);
+  void fillCircle(int16_t cx, int16_t cy, int16_t radius);
+  void drawArc(int16_t cx, int16_t cy, int16_t radius, uint8_t startAngle, uint8_t endAngle);
+  void drawRoundRect(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius);
+  void fillRoundRect(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius);
+
   private:
 
-  static uint8_t m_buffer[1024];
-};
+  // A range of columns within a page, empty when left > right.
+  struct Span {
+    uint8_t left, right;
 
+    bool isEmpty() const { return left > right; }
+    void empty() { left = 0xff; right = 0; }
+    void fill() { left = 0; right = 127; }
+    void extend(uint8_t x) {
+      if (x < left) { left = x; }
+      if (x > right) { right = x; }
+    }
+    void extend(uint8_t l, uint8_t r) {
+      if (l < left) { left = l; }
+      if (r > right) { right = r; }
+    }
+    void extend(Span other) {
+      if (other.left < left) { left = other.left; }
+      if (other.right > right) { right = other.right; }
+    }
+  };
+
+  static constexpr uint8_t c_bufferPages = SSD1306_BUFFER_PAGES;
+  static_assert(c_bufferPages == 1 || c_bufferPages == 2 || c_bufferPages == 4 || c_bufferPages == 8,
+                "SSD1306_BUFFER_PAGES must divide the 8 display pages.");
+
+  // The rows held by the buffer, which everything drawn is clipped to.
+  static int16_t clipTop() { return m_bandPage * 8; }
+  static int16_t clipBottom() { return (m_bandPage + c_bufferPages) * 8 - 1; }
+
+  static uint8_t* bufferAt(uint8_t page, uint8_t x) {
+    return m_buffer + ((page - m_bandPage) * 128) + x;
+  }
+
+  void markDirty(uint8_t left, uint8_t top, uint8_t right, uint8_t bottom);
+
+  void drawThickLine(int16_t ax, int16_t ay, int16_t bx, int16_t by, uint8_t width);
+
+  void roundRect(int16_t left, int16_t top, int16_t right, int16_t bottom, int16_t radius, bool fill);
+
+  void countLit(uint8_t page, uint8_t left, uint8_t right);
+  void setLit(uint8_t page, uint8_t left, uint8_t right, const uint8_t* blockLit);
+
+  static uint8_t m_buffer[c_bufferPages * 128];
+
+#if SSD1306_BUFFER_PAGES < 8
+  // The first page in the buffer, and whether this picture loop is retaining the display.
+  static uint8_t m_bandPage;
+  static bool m_retaining;
+#else
+  static constexpr uint8_t m_bandPage = 0;
+  static constexpr bool m_retaining = false;
+#endif
+
+  // Per page, the columns which have changed since the last flush and the columns which may have
+  // pixels set since the last clear.  When drawing in bands each pass starts by clearing its pages,
+  // so the columns left lit by the previous frame are resent along with whatever is drawn.
+  static Span m_dirty[8];
+  static Span m_used[8];
+
+  // The lit pixels in each block of 16 columns of each page of the display RAM.
+  static constexpr uint8_t c_litBlockCols = 16;
+  static uint8_t m_blockLit[8][128 / c_litBlockCols];
+
+  // The display's contrast and inversion.
+  uint8_t m_contrast = 0xff;
+  bool m_inverted = false;
+};
@@ -0,0 +1,119 @@
+#include <Arduino.h>
+
+#include "trace.h"
+
+#if SIO4_TRACE
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+  constexpr uint8_t c_traceEndFlag = 0x80;
+  constexpr uint8_t c_traceEventCount = 32;
+
+  struct TraceEvent {
+    uint8_t phase;        // With c_traceEndFlag set for the end of a phase.
+    uint32_t us;
+  };
+
+  // The ring of events, oldest at g_traceFirst.
+  TraceEvent g_traceEvents[c_traceEventCount];
+  uint8_t g_traceFirst = 0;
+  uint8_t g_traceLen = 0;
+
+  void traceEvent(uint8_t phase) {
+    uint8_t idx = (g_traceFirst + g_traceLen) % c_traceEventCount;
+    if (g_traceLen < c_traceEventCount) {
+      g_traceLen++;
+    } else {
+      g_traceFirst = (g_traceFirst + 1) % c_traceEventCount;
+    }
+    g_traceEvents[idx].phase = phase;
+    g_traceEvents[idx].us = micros();
+  }
+
+  const char c_nameWake[] PROGMEM = "wake";
+  const char c_nameRtc[] PROGMEM = "rtc";
+  const char c_nameBattery[] PROGMEM = "battery";
+  const char c_nameRender[] PROGMEM = "render";
+  const char c_nameFlush[] PROGMEM = "flush";
+  const char c_nameAwake[] PROGMEM = "awake";
+
+  const char* const c_phaseNames[TracePhaseCount] PROGMEM = {
+    c_nameWake, c_nameRtc, c_nameBattery, c_nameRender, c_nameFlush, c_nameAwake,
+  };
+
+  const char c_nameLines[] PROGMEM = "lines";
+  const char c_namePixels[] PROGMEM = "pixels";
+  const char c_nameSpiBytes[] PROGMEM = "spi-bytes";
+  const char c_nameLitPixels[] PROGMEM = "lit-pixels";
+  const char c_nameDisplayUa[] PROGMEM = "display-ua";
+
+  const char* const c_counterNames[TraceCounterCount] PROGMEM = {
+    c_nameLines, c_namePixels, c_nameSpiBytes, c_nameLitPixels, c_nameDisplayUa,
+  };
+
+  void printP(Print& out, const char* const* names, uint8_t idx) {
+    const char* name = static_cast<const char*>(pgm_read_ptr(&(names[idx])));
+    for (char ch = pgm_read_byte(name); ch != '\0'; ch = pgm_read_byte(++name)) {
+      out.print(ch);
+    }
+  }
+}
+
+uint32_t g_traceCounters[TraceCounterCount];
+
+// -------------------------------------------------------------------------------------------------
+
+void traceBegin(TracePhase phase) {
+  traceEvent(phase);
+}
+
+void traceEnd(TracePhase phase) {
+  traceEvent(phase | c_traceEndFlag);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Each phase end is matched with the latest begin before it, so nested and repeated phases work.
+// Ends whose begin has dropped out of the ring are skipped.
+
+void traceDump(Print& out) {
+  for (uint8_t endIdx = 0; endIdx < g_traceLen; endIdx++) {
+    const TraceEvent& end = g_traceEvents[(g_traceFirst + endIdx) % c_traceEventCount];
+    if ((end.phase & c_traceEndFlag) == 0) {
+      continue;
+    }
+
+    uint8_t phase = end.phase & ~c_traceEndFlag;
+    for (uint8_t beginIdx = endIdx; beginIdx-- > 0; ) {
+      const TraceEvent& begin = g_traceEvents[(g_traceFirst + beginIdx) % c_traceEventCount];
+      if (begin.phase == phase) {
+        printP(out, c_phaseNames, phase);
+        out.print(F(": "));
+        out.print(end.us - begin.us);
+        out.println(F("us"));
+        break;
+      }
+    }
+  }
+
+  for (uint8_t counter = 0; counter < TraceCounterCount; counter++) {
+    printP(out, c_counterNames, counter);
+    out.print(F(": "));
+    out.println(g_traceCounters[counter]);
+  }
+
+  traceReset();
+}
+
+void traceReset() {
+  g_traceFirst = 0;
+  g_traceLen = 0;
+  for (uint8_t counter = 0; counter < TraceCounterCount; counter++) {
+    g_traceCounters[counter] = 0;
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+#endif
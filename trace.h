@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Wake cycle tracing.  Phases are timestamped with micros() into a small ring buffer and a few
+// counters tally the work done, all dumped over serial by the console's C command.  Compiled out
+// unless SIO4_TRACE is 1, in which case it costs about 200 bytes of RAM.
+
+#ifndef SIO4_TRACE
+#define SIO4_TRACE 0
+#endif
+
+enum TracePhase : uint8_t {
+  TraceWake,        // Waking from power down until the face is showing.
+  TraceRtc,         // Restarting the clock's tick and syncing it on waking.
+  TraceBattery,     // Reading the battery level.
+  TraceRender,      // Drawing the face, including flushing it.
+  TraceFlush,       // Sending the buffer to the display.
+  TraceAwake,       // The whole time the face is showing.
+  TracePhaseCount,
+};
+
+enum TraceCounter : uint8_t {
+  TraceLines,       // Lines drawn by the display.
+  TracePixels,      // Pixels plotted.
+  TraceSpiBytes,    // Bytes sent to the display.
+  TraceLitPixels,   // Pixels lit on the face as shown, set rather than counted.
+  TraceDisplayUa,   // The estimated display current for the face as shown, also set.
+  TraceCounterCount,
+};
+
+#if SIO4_TRACE
+
+void traceBegin(TracePhase phase);
+void traceEnd(TracePhase phase);
+
+extern uint32_t g_traceCounters[TraceCounterCount];
+
+inline void traceCount(TraceCounter counter, uint16_t count = 1) {
+  g_traceCounters[counter] += count;
+}
+
+inline void traceSet(TraceCounter counter, uint32_t value) {
+  g_traceCounters[counter] = value;
+}
+
+inline uint32_t traceCounter(TraceCounter counter) {
+  return g_traceCounters[counter];
+}
+
+// Print the phase timings and counters then reset them.
+void traceDump(class Print& out);
+void traceReset();
+
+#else
+
+inline void traceBegin(TracePhase ) {}
+inline void traceEnd(TracePhase ) {}
+inline void traceCount(TraceCounter , uint16_t = 1) {}
+inline void traceSet(TraceCounter , uint32_t ) {}
+inline uint32_t traceCounter(TraceCounter ) { return 0; }
+inline void traceDump(class Print& ) {}
+inline void traceReset() {}
+
+#endif
+
+// Trace a phase for the rest of the enclosing scope.
+struct TraceScope {
+  explicit TraceScope(TracePhase phase) : m_phase(phase) { traceBegin(phase); }
+  ~TraceScope() { traceEnd(m_phase); }
+
+  private:
+
+  TracePhase m_phase;
+};
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+#include <Arduino.h>
+
+#include "trig.h"
+
+// -------------------------------------------------------------------------------------------------
+// The sine table covers a quarter turn, 0 to 64 inclusive, the rest being mirrored from it.  It's
+// filled by a constexpr Taylor series over an index sequence, so costs nothing at run time and can be
+// changed without a script to generate it.
+
+namespace {
+
+  constexpr double c_pi = 3.14159265358979;
+
+  // sin(x) for 0 <= x <= pi / 2, summing terms up to x^13 which is plenty for 8 bits.
+  constexpr double sineTerms(double xx, double term, int power) {
+    return power > 13 ? 0 : term + sineTerms(xx, -term * xx / ((power + 1) * (power + 2)), power + 2);
+  }
+
+  constexpr uint8_t quarterSine(uint8_t index) {
+    return static_cast<uint8_t>(
+      sineTerms((index * c_pi / 128) * (index * c_pi / 128), index * c_pi / 128, 1) * 255 + 0.5);
+  }
+
+  // C++11 has no std::index_sequence, and the AVR no STL anyway.
+  template <uint8_t... Indices> struct IndexSequence {};
+
+  template <uint8_t Count, uint8_t... Indices>
+  struct MakeIndexSequence : MakeIndexSequence<Count - 1, Count - 1, Indices...> {};
+
+  template <uint8_t... Indices>
+  struct MakeIndexSequence<0, Indices...> {
+    using Type = IndexSequence<Indices...>;
+  };
+
+  struct SineTable {
+    uint8_t values[65];
+  };
+
+  template <uint8_t... Indices> constexpr SineTable makeSineTable(IndexSequence<Indices...>) {
+    return SineTable { { quarterSine(Indices)... } };
+  }
+
+  constexpr SineTable c_sineTable PROGMEM = makeSineTable(MakeIndexSequence<65>::Type());
+
+  static_assert(quarterSine(0) == 0 && quarterSine(64) == 255, "The sine table is out.");
+}
+
+// -------------------------------------------------------------------------------------------------
+
+int16_t isin(uint8_t angle) {
+  uint8_t index = angle & 0x3f;
+  if (angle & 0x40) {
+    // The second and fourth quarters run back down the table.
+    index = 64 - index;
+  }
+  int16_t value = pgm_read_byte(&(c_sineTable.values[index]));
+  return (angle & 0x80) ? -value : value;
+}
+
+int16_t icos(uint8_t angle) {
+  return isin(angle + 64);
+}
+
+// -------------------------------------------------------------------------------------------------
+// The screen's y grows downwards, so clockwise from 12 o'clock is +sin across and -cos down.
+
+TrigPoint polarPoint(int8_t cx, int8_t cy, int8_t length, uint8_t angle) {
+  return TrigPoint {
+    static_cast<int8_t>(cx + trigScale(length, isin(angle))),
+    static_cast<int8_t>(cy - trigScale(length, icos(angle))),
+  };
+}
+
+TrigPoint rotatePoint(int8_t dx, int8_t dy, uint8_t angle) {
+  int16_t sine = isin(angle);
+  int16_t cosine = icos(angle);
+  return TrigPoint {
+    static_cast<int8_t>(trigScale(dx, cosine) - trigScale(dy, sine)),
+    static_cast<int8_t>(trigScale(dx, sine) + trigScale(dy, cosine)),
+  };
+}
+
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+// -------------------------------------------------------------------------------------------------
+// Integer trig.  Angles are in 256ths of a turn, clockwise from 12 o'clock, as for the display's
+// arcs, and sines and cosines are fixed point with 255 standing for 1.  They come from a quarter wave
+// table in PROGMEM which is worked out at compile time.
+
+int16_t isin(uint8_t angle);
+int16_t icos(uint8_t angle);
+
+// Multiply by a sine or cosine, rounding to the nearest.
+inline int16_t trigScale(int16_t length, int16_t trig) {
+  return (static_cast<int32_t>(length) * trig + 128) >> 8;
+}
+
+struct TrigPoint {
+  int8_t x, y;
+};
+
+// The point length from cx, cy at angle, e.g. the tip of a hand.
+TrigPoint polarPoint(int8_t cx, int8_t cy, int8_t length, uint8_t angle);
+
+// An offset turned clockwise by angle, for shapes drawn pointing at 12 o'clock.
+TrigPoint rotatePoint(int8_t dx, int8_t dy, uint8_t angle);
+
+// -------------------------------------------------------------------------------------------------
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <stdint.h>
+
 // -------------------------------------------------------------------------------------------------
+// The one PRNG state, owned by jitter.cpp which seeds and rewinds it per frame.
+
+extern uint16_t g_prng;
 
-static uint16_t prng = 1;
 inline uint16_t xorShift() {
-  prng ^= prng << 7;
-  prng ^= prng >> 9;
-  prng ^= prng << 8;
-  return prng;
+  g_prng ^= g_prng << 7;
+  g_prng ^= g_prng >> 9;
+  g_prng ^= g_prng << 8;
+  return g_prng;
 }
 
 // -------------------------------------------------------------------------------------------------